@@ -3,129 +3,1174 @@
 // Inclide Libraries:
 
 #include "Button.h"
+#include "ButtonChip.h"
+#include "ButtonGroup.h"
+#include "ButtonTrace.h"
+#include "DebounceEngine.h"
+#include <cerrno>
 #include <cstdlib>
-#include <iostream>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <alloca.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+#include <sys/prctl.h>
+#include <unistd.h>
 
 // #######################################################################
-// Button class:
+// Helpers:
 
-Button::Button(const char* gpiodChip_path, unsigned int pin, uint8_t mode, uint8_t bias)
-: _auxi(gpiodChip_path, pin, mode, bias)
-{}
+/**
+ * @brief CLOCK_MONOTONIC in nanoseconds (same clock as kernel line event timestamps).
+ */
+static int64_t monotonicNs(void)
+{
+    timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
 
-bool Button::begin()
+// #######################################################################
+// ButtonWaitList class:
+
+void ButtonWaitList::open(int wakeFd)
 {
-    if (!_auxi.begin()) {
-        errorMessage = "AUXI begin() failed: " + _auxi.errorMessage;
-        return false;
+    std::lock_guard<std::mutex> lock(_lock);
+    _wakeFd = wakeFd;
+    _open = true;
+}
+
+void ButtonWaitList::close(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _open = false;
+        _wakeFd = -1;
+    }
+    _take([](ButtonWaiter& w) { w.timedOut = true; return true; });
+}
+
+bool ButtonWaitList::add(ButtonWaiter& w)
+{
+    bool wake = false;
+    int fd;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (!_open) return false;
+        // Re-check under the lock: the release may have been dispatched meanwhile
+        if (w.want == ButtonWaiter::Release && !w.btn->get()) return false;
+
+        w.next = nullptr;
+        w.timedOut = false;
+        if (_tail) _tail->next = &w;
+        else       _head = &w;
+        _tail = &w;
+        _pending.store(true, std::memory_order_release);
+
+        if (w.deadline_ns < _deadline_ns.load(std::memory_order_relaxed)) {
+            _deadline_ns.store(w.deadline_ns, std::memory_order_relaxed);
+            wake = true;
+        }
+        fd = _wakeFd;
+    }
+
+    // The loop may be sleeping past the new deadline (w must not be touched any more)
+    if (wake && fd >= 0) {
+        uint64_t one = 1;
+        if (::write(fd, &one, sizeof(one)) < 0) {
+            // Counter saturated: the loop is already due to wake up
+        }
     }
     return true;
 }
 
-bool Button::beginInterrupt(uint8_t edge, uint32_t debounce_us, GpioCallback cb)
+void ButtonWaitList::complete(Button* btn, const ButtonEvent& ev)
 {
-    if (!cb) {
-        errorMessage = "Button: callback is null.";
-        return false;
+    _take([btn, &ev](ButtonWaiter& w) {
+        if (w.btn != btn) return false;
+        if (w.want == ButtonWaiter::Press && !ev.rising) return false;
+        if (w.want == ButtonWaiter::Release && ev.rising) return false;
+        w.ev = ev;
+        return true;
+    });
+}
+
+void ButtonWaitList::expire(int64_t now_ns)
+{
+    if (now_ns < _deadline_ns.load(std::memory_order_relaxed)) return;
+
+    _take([now_ns](ButtonWaiter& w) {
+        if (w.deadline_ns > now_ns) return false;
+        w.timedOut = true;
+        return true;
+    });
+}
+
+void ButtonWaitList::retarget(Button* from, Button* to)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    for (ButtonWaiter* w = _head; w; w = w->next) {
+        if (w->btn == from) w->btn = to;
     }
+}
 
-    // Ensure line is requested as input
-    if (!_auxi.begin()) {
-        errorMessage = "AUXI begin() failed: " + _auxi.errorMessage;
-        return false;
+void ButtonWaitList::drop(Button* btn)
+{
+    _take([btn](ButtonWaiter& w) {
+        if (w.btn != btn) return false;
+        w.timedOut = true;
+        return true;
+    });
+}
+
+int ButtonWaitList::timeoutMs(int64_t now_ns) const
+{
+    const int64_t d = _deadline_ns.load(std::memory_order_relaxed);
+    if (d == INT64_MAX) return -1;
+    if (d <= now_ns) return 0;
+    const int64_t ms = (d - now_ns + 999999LL) / 1000000LL;
+    return ms > INT_MAX ? INT_MAX : static_cast<int>(ms);
+}
+
+template <typename Pick>
+void ButtonWaitList::_take(Pick pick)
+{
+    ButtonWaiter* done = nullptr;
+    ButtonWaiter** doneTail = &done;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        int64_t next = INT64_MAX;
+        ButtonWaiter* prev = nullptr;
+        ButtonWaiter* w = _head;
+        while (w) {
+            ButtonWaiter* after = w->next;
+            if (pick(*w)) {
+                if (prev) prev->next = after;
+                else      _head = after;
+                if (_tail == w) _tail = prev;
+                w->next = nullptr;
+                *doneTail = w;
+                doneTail = &w->next;
+            } else {
+                if (w->deadline_ns < next) next = w->deadline_ns;
+                prev = w;
+            }
+            w = after;
+        }
+        _deadline_ns.store(next, std::memory_order_relaxed);
+        _pending.store(_head != nullptr, std::memory_order_release);
     }
 
+    // Resume outside the lock: a resumed coroutine may immediately wait again
+    while (done) {
+        ButtonWaiter* w = done;
+        done = w->next;
+        w->resume(w);       // may destroy *w
+    }
+}
+
+// #######################################################################
+// Button class:
+
+Button::Button(const char* gpiodChip_path, unsigned int pin, uint8_t mode, uint8_t bias)
+: _auxi(new ButtonInput(gpiodChip_path, pin, mode, bias)),
+  _chipPath(gpiodChip_path ? gpiodChip_path : ""),
+  _pin(pin),
+  _mode(mode),
+  _bias(bias)
+{}
+
+Button::Button(Button&& other)
+{
+    _moveFrom(other);
+}
+
+Button& Button::operator=(Button&& other)
+{
+    if (this == &other) return *this;
+
+    if (_group) _group->remove(*this);
+    clean();
+    _moveFrom(other);
+    return *this;
+}
+
+Button::~Button()
+{
+    if (_group) _group->remove(*this);      // no group entry may outlive the button
+    stopInterrupt();
+    _releaseEvents();
+}
+
+bool Button::begin()
+{
+    return _report(tryBegin());
+}
+
+ButtonError Button::tryBegin(void)
+{
+    if (_eventsRequested()) return _fail(ButtonError::None);    // already requested by the event path
+
+    if (!_auxi->begin()) return _fail(ButtonError::AuxiBegin);
+    return _fail(ButtonError::None);
+}
+
+bool Button::beginInterrupt(uint8_t edge, uint32_t debounce_us, ButtonDelegate cb)
+{
     AUXI::Edge sel;
     switch (edge) {
         case 0:  sel = AUXI::Edge::Both;    break;
         case 1:  sel = AUXI::Edge::Rising;  break;
         case 2:  sel = AUXI::Edge::Falling; break;
-        default:
-            errorMessage = "edge selection is not correct (must be 0,1,2).";
-            return false;
+        default: return _report(_fail(ButtonError::InvalidEdge));
     }
+    return beginInterrupt(sel, debounce_us, cb);
+}
 
-    if (!_auxi.beginInterrupt(sel, debounce_us, cb)) {
-        errorMessage = "AUXI beginInterrupt() failed: " + _auxi.errorMessage;
-        return false;
+bool Button::beginInterrupt(AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb)
+{
+    return _report(tryBeginInterrupt(edge, debounce_us, cb));
+}
+
+ButtonError Button::tryBeginInterrupt(AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb)
+{
+    if (!cb && !_queue && !_coalesce) return _fail(ButtonError::NullCallback);
+
+    stopInterrupt();
+
+    if (!_requestEvents(edge, debounce_us, cb)) return _lastError;
+
+    if (_startEventThread() != ButtonError::None) _releaseEvents();
+    return _lastError;
+}
+
+bool Button::beginInterrupt(AUXI::Edge edge, uint32_t debounce_us, GpioUserCallback cb, void* user)
+{
+    if (!cb) return _report(_fail(ButtonError::NullCallback));
+    return beginInterrupt(edge, debounce_us, ButtonDelegate(cb, user));
+}
+
+bool Button::beginEvents(uint8_t edge, uint32_t debounce_us, ButtonDelegate cb)
+{
+    AUXI::Edge sel;
+    switch (edge) {
+        case 0:  sel = AUXI::Edge::Both;    break;
+        case 1:  sel = AUXI::Edge::Rising;  break;
+        case 2:  sel = AUXI::Edge::Falling; break;
+        default: return _report(_fail(ButtonError::InvalidEdge));
     }
-    return true;
+    return beginEvents(sel, debounce_us, cb);
 }
 
-bool Button::beginInterrupt(AUXI::Edge edge, uint32_t debounce_us, GpioCallback cb)
+bool Button::beginEvents(AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb)
 {
-    if (!cb) {
-        errorMessage = "Button: callback is null.";
-        return false;
+    return _report(tryBeginEvents(edge, debounce_us, cb));
+}
+
+ButtonError Button::tryBeginEvents(AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb)
+{
+    if (!cb && !_queue && !_coalesce) return _fail(ButtonError::NullCallback);
+
+    stopInterrupt();
+
+    if (!_requestEvents(edge, debounce_us, cb)) return _lastError;
+
+    // No wake fd: await deadlines are honoured through eventTimeoutMs()
+    _waits.open(-1);
+    _evWaitList.store(&_waits, std::memory_order_release);
+    return _fail(ButtonError::None);
+}
+
+ButtonError Button::lastError(void) const
+{
+    if (_evGone.load(std::memory_order_acquire)) return ButtonError::LineGone;
+    return _lastError;
+}
+
+int Button::lastErrno(void) const
+{
+    const int gone = _evGone.load(std::memory_order_acquire);
+    return gone ? gone : _lastErrno;
+}
+
+int Button::eventFd(void) const
+{
+    return _eventFd();
+}
+
+size_t Button::processPendingEvents(void)
+{
+    if (!_eventsRequested()) return 0;
+
+    _stats.add(ButtonStats::Wakeups);
+    const size_t n = _handleEvents();
+    if (_coalesce) _expireCoalesced(monotonicNs());
+    if (_waits.pending()) _waits.expire(monotonicNs());
+    return n;
+}
+
+int Button::eventTimeoutMs(void) const
+{
+    const int64_t now = monotonicNs();
+    int timeout = _waits.timeoutMs(now);
+    if (_coalesce && _coalesce->deadline_ns >= 0) {
+        const int64_t d = _coalesce->deadline_ns - now;
+        const int ct = d <= 0 ? 0 : static_cast<int>((d + 999999LL) / 1000000LL);
+        if (timeout < 0 || ct < timeout) timeout = ct;
     }
-    if (!_auxi.begin()) {
-        errorMessage = "AUXI begin() failed: " + _auxi.errorMessage;
-        return false;
+    return timeout;
+}
+
+void Button::stopInterrupt()
+{
+    if (_evRunning.exchange(false)) {
+        uint64_t one = 1;
+        if (::write(_evWakeFd, &one, sizeof(one)) < 0) {
+            // The loop also re-checks the flag after every wakeup
+        }
     }
-    if (!_auxi.beginInterrupt(edge, debounce_us, cb)) {
-        errorMessage = "AUXI beginInterrupt() failed: " + _auxi.errorMessage;
-        return false;
+    if (_evThread.joinable()) _evThread.join();
+
+    ButtonWaitList* own = &_waits;
+    _evWaitList.compare_exchange_strong(own, nullptr);
+    _waits.close();     // pending awaits complete as timed out
+
+    if (_evWakeFd >= 0) {
+        ::close(_evWakeFd);
+        _evWakeFd = -1;
     }
-    return true;
 }
 
-void Button::stopInterrupt()
+void Button::setThreadOptions(const ButtonThreadOptions& opts)
+{
+    _threadOpts = opts;
+}
+
+void Button::enableEventQueue(size_t capacity)
+{
+    _queue.reset(new SpscRing<ButtonEvent>(capacity));
+}
+
+size_t Button::pollEvents(ButtonEvent* out, size_t max)
+{
+    return _queue ? _queue->pop(out, max) : 0;
+}
+
+#if __cplusplus >= 202002L
+size_t Button::pollEvents(std::span<ButtonEvent>& out)
+{
+    const size_t n = pollEvents(out.data(), out.size());
+    out = out.first(n);
+    return n;
+}
+#endif
+
+uint64_t Button::eventOverflows(void) const
+{
+    return _queue ? _queue->overflows() : 0;
+}
+
+ButtonStatsSnapshot Button::stats(void) const
+{
+    ButtonStatsSnapshot s = _stats.snapshot();
+    s.overflows = eventOverflows();
+    return s;
+}
+
+void Button::resetStats(void)
+{
+    _stats.reset();
+}
+
+void Button::setTraceRecorder(ButtonTraceRecorder* rec)
+{
+    _trace = rec;
+    _traceChip = buttonTraceChip(_chipPath);
+}
+
+void Button::enableLatencyStats(void)
+{
+    if (!_latency) _latency.reset(new LatencyStats);
+}
+
+const LatencyHistogram* Button::deliveryLatency(void) const
 {
-    _auxi.stopInterrupt();
+    return _latency ? &_latency->delivery : nullptr;
+}
+
+const LatencyHistogram* Button::callbackLatency(void) const
+{
+    return _latency ? &_latency->callback : nullptr;
 }
 
 void Button::clean()
 {
     stopInterrupt();
-    _auxi.clean();
+    _releaseEvents();
+    if (_auxi) {
+        _auxi->stopInterrupt();
+        _auxi->clean();
+    }
 }
 
 int Button::value()
 {
-    return _auxi.value();   // RAW electrical level: 0/1 or -1 on error
+    if (_evPolled) return (_mode == 0) ? !get() : get();     // sampled by a ButtonGroup poller
+
+    if (_eventsRequested()) {
+        // Event line is requested with active-low for mode 0, so undo polarity
+        int v = _readEventLine();
+        if (v < 0) return -1;
+        return (_mode == 0) ? !v : v;
+    }
+    return _auxi->value();   // RAW electrical level: 0/1 or -1 on error
 }
 
 bool Button::read(void)
 {
-    return _auxi.read();    // LOGICAL, polarity-applied
+    if (_evPolled) return get();    // sampled by a ButtonGroup poller
+
+    if (_eventsRequested()) {
+        // Application thread: the cached state and stats belong to the serving thread
+        int v = _readEventLine();
+        return v >= 0 ? (v == 1) : get();
+    }
+    return _auxi->read();    // LOGICAL, polarity-applied
 }
 
 bool Button::get(void)
 {
-    return _auxi.get(); // cached LOGICAL
+    if (_eventsRequested() || _evPolled) return (_evStateSeq.load(std::memory_order_acquire) & 1ULL) != 0;
+    return _auxi->get(); // cached LOGICAL
 }
 
-// ####################################################################
-// ResetButton class:
+uint64_t Button::sequence(void) const
+{
+    return _evStateSeq.load(std::memory_order_acquire) >> 1;
+}
 
-bool ResetButton::check()
+bool Button::changedSince(uint64_t seq) const
+{
+    return sequence() != seq;
+}
+
+void Button::setDebounceMode(Debounce mode)
+{
+    _debounceMode = mode;
+}
+
+bool Button::kernelDebounce(void) const
+{
+    return _evReq.kernelDebounce();
+}
+
+void Button::setEventClock(EventClock clock)
+{
+    _evClock = clock;
+}
+
+Button::EventClock Button::eventClock(void) const
 {
-    if (!read()) return false;
+    return _evClock;
+}
 
-    using namespace std::chrono_literals;
+void Button::setCoalescing(uint32_t window_us, ButtonSummaryCallback cb, void* user)
+{
+    if (window_us == 0 || !cb) {
+        flushCoalesced();
+        _coalesce.reset();
+        return;
+    }
+    if (!_coalesce) {
+        _coalesce.reset(new Coalescer);
+        _coalesce->timer.fn = &Button::_onCoalesceTimer;
+        _coalesce->timer.ctx = this;
+    }
+    _coalesce->cb = cb;
+    _coalesce->user = user;
+    _coalesce->window_ns = static_cast<int64_t>(window_us) * 1000LL;
+}
 
-    std::cout << "System is Resetting ... !\n";
-    std::this_thread::sleep_for(1s);
-    std::cout << "3 Sec\n";
-    std::this_thread::sleep_for(1s);
-    std::cout << "2 Sec\n";
-    std::this_thread::sleep_for(1s);
-    std::cout << "1 Sec\n";
-    std::this_thread::sleep_for(1s);
+void Button::flushCoalesced(void)
+{
+    if (!_coalesce) return;
+
+    Coalescer& c = *_coalesce;
+    if (_group) _group->_coalesceWheel.cancel(c.timer);
+    c.deadline_ns = -1;
+    if (c.open.count == 0) return;
+
+    const ButtonEdgeSummary sum = c.open;
+    c.open.count = 0;
 
-    if (read()) {
-        std::cout << "System is Shutdown ... !\n";
-        std::this_thread::sleep_for(1s);
-        std::system("sudo /sbin/shutdown -h now");
-        for (;;) std::this_thread::sleep_for(1s);
+    _stats.add(ButtonStats::Callbacks);
+    if (_latency) {
+        const int64_t entry = monotonicNs();
+        _latency->delivery.record(entry - static_cast<int64_t>(sum.last_ns));
+        c.cb(c.user, sum);
+        _latency->callback.record(monotonicNs() - entry);
+    } else {
+        c.cb(c.user, sum);
     }
+}
+
+bool Button::_requestEvents(AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb)
+{
+    // The line can only be requested once: drop AUXI's request and any previous one
+    _auxi->stopInterrupt();
+    _auxi->clean();
+    _releaseEvents();
 
-    std::system("sudo /sbin/reboot");
-    for (;;) std::this_thread::sleep_for(1s);
+    // Buttons on the same chip share one opened handle; it stays cached while the request lives
+    _evChip = ButtonChipCache::acquire(_chipPath);
 
-    // Unreachable
+    ButtonLineConfig cfg;
+    cfg.offset = _pin;
+    cfg.edge = edge;
+    cfg.activeLow = (_mode == 0);
+    cfg.bias = _bias;
+    cfg.clock = _evClock;
+
+    int err = 0;
+    ButtonError e = ButtonError::None;
+    if (_debounceMode != Debounce::Software && debounce_us > 0) {
+        cfg.debounce_us = debounce_us;
+        e = _evReq.request(_evChip, cfg, err);
+        if (e != ButtonError::None && _debounceMode == Debounce::Kernel) {
+            _fail(e, err);
+            _releaseEvents();
+            return false;
+        }
+    }
+    if (!_evReq.requested()) {
+        cfg.debounce_us = 0;
+        err = 0;
+        e = _evReq.request(_evChip, cfg, err);
+        if (e != ButtonError::None) {
+            _fail(e, err);
+            _releaseEvents();
+            return false;
+        }
+    }
+
+    // Non-blocking fd lets _handleEvents() drain the kernel FIFO without a final blocking read
+    const int fd = _evReq.fd();
+    const int fl = ::fcntl(fd, F_GETFL);
+    if (fl < 0 || ::fcntl(fd, F_SETFL, fl | O_NONBLOCK) < 0) {
+        _fail(ButtonError::NonBlock, errno);
+        _releaseEvents();
+        return false;
+    }
+
+    _evCb = cb;
+    _evEdge = edge;
+    _evDebounce_us = _evReq.kernelDebounce() ? 0 : debounce_us;     // kernel already filters bounces
+    _evLast_ns = -1;
+
+    int v = _readEventLine();
+    _publishState(v == 1, 0);
+    return true;
+}
+
+void Button::_releaseEvents(void)
+{
+    _evGone.store(0, std::memory_order_relaxed);
+    _evReq.release();
+    if (_evChip) {
+        ButtonChipCache::release(_evChip);
+        _evChip = nullptr;
+    }
+    _evDebouncer = nullptr;
+}
+
+bool Button::_eventsRequested(void) const
+{
+    return _evReq.requested();
+}
+
+int Button::_eventFd(void) const
+{
+    return _evReq.fd();
+}
+
+int Button::_readEventLine(void)
+{
+    if (!_evReq.requested()) return -1;
+    return _evReq.value();
+}
+
+size_t Button::_handleEvents(void)
+{
+    ButtonEvent evs[EVENT_BATCH];
+    size_t total = 0;
+
+    for (;;) {
+        // fd is non-blocking: each read returns what is queued (up to EVENT_BATCH) or EAGAIN
+        _stats.add(ButtonStats::Syscalls);
+        const int n = _evReq.read(evs, EVENT_BATCH, _pin);
+        if (n <= 0) return total;
+
+        _processBatch(evs, static_cast<size_t>(n));
+        total += static_cast<size_t>(n);
+
+        if (static_cast<unsigned int>(n) < EVENT_BATCH) return total;   // kernel FIFO drained
+    }
+}
+
+void Button::_processRaw(const void* data, size_t bytes)
+{
+    ButtonEvent evs[EVENT_BATCH];
+    _processBatch(evs, _evReq.decode(data, bytes, evs, EVENT_BATCH, _pin));
+}
+
+size_t Button::_rawBatchBytes(void) const
+{
+    return EVENT_BATCH * _evReq.eventBytes();
+}
+
+void Button::_processBatch(ButtonEvent* evs, size_t n)
+{
+    if (n == 0) return;
+
+    _stats.add(ButtonStats::Edges, n);
+    if (_trace) {
+        for (size_t i = 0; i < n; ++i) _trace->record(evs[i], _traceChip);
+    }
+
+    if (_evEdge == AUXI::Edge::Both) {
+        _publishState(evs[n - 1].rising, n);   // line state follows the newest raw edge
+    }
+    else {
+        // Single-edge requests never report the opposite edge: sample the level
+        _stats.add(ButtonStats::Syscalls);
+        int v = _readEventLine();
+        _publishState(v >= 0 ? (v == 1) : evs[n - 1].rising, n);
+    }
+
+    _debounceDispatch(evs, n);
+}
+
+void Button::_debounceDispatch(ButtonEvent* evs, size_t n)
+{
+    if (_evDebouncer) {
+        // Group-level debouncer decides and calls back into _dispatch()
+        for (size_t i = 0; i < n; ++i) {
+            _evDebouncer->onEdge(_evDebounceId, evs[i].rising,
+                                 static_cast<int64_t>(evs[i].ts_ns));
+        }
+        return;
+    }
+
+    const int64_t window_ns = static_cast<int64_t>(_evDebounce_us) * 1000LL;
+
+    // Compact accepted edges to the front of the batch
+    size_t kept = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const int64_t ns = static_cast<int64_t>(evs[i].ts_ns);
+        if (_evLast_ns >= 0 && (ns - _evLast_ns) < window_ns) continue;    // bounce
+        _evLast_ns = ns;
+        evs[kept++] = evs[i];
+    }
+    _stats.add(ButtonStats::Accepted, kept);
+
+    for (size_t i = 0; i < kept; ++i) {
+        _dispatch(evs[i]);
+    }
+}
+
+void Button::_beginPolled(AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb, bool state)
+{
+    _evPolled = true;
+    _evEdge = edge;
+    _evCb = cb;
+    _evDebounce_us = debounce_us;
+    _evLast_ns = -1;
+    _publishState(state, 0);
+}
+
+void Button::_pollSample(bool state, int64_t now_ns)
+{
+    _publishState(state, 1);
+
+    if ((state && _evEdge == AUXI::Edge::Falling) || (!state && _evEdge == AUXI::Edge::Rising)) return;
+
+    ButtonEvent ev = ButtonEvent::make(state, _pin, static_cast<uint64_t>(now_ns));
+    _stats.add(ButtonStats::Edges);
+    if (_trace) _trace->record(ev, _traceChip);
+    _debounceDispatch(&ev, 1);
+}
+
+void Button::_publishState(bool state, uint64_t edges)
+{
+    uint64_t cur = _evStateSeq.load(std::memory_order_relaxed);
+    uint64_t next;
+    do {
+        next = ((((cur >> 1) + edges) << 1) | (state ? 1ULL : 0ULL));
+    } while (!_evStateSeq.compare_exchange_weak(cur, next, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void Button::_dispatch(const ButtonEvent& ev)
+{
+    if (_chordBit >= 0) _group->_chordEdge(static_cast<unsigned int>(_chordBit), ev.rising, static_cast<int64_t>(ev.ts_ns));
+    if (_queue) _queue->push(ev);
+
+    if (_coalesce) _coalesceEdge(ev);
+    else           _callEdge(ev);
+
+    // Awaiting coroutines resume last, so they never delay the callback
+    ButtonWaitList* waits = _evWaitList.load(std::memory_order_acquire);
+    if (waits && waits->pending()) waits->complete(this, ev);
+}
+
+void Button::_callEdge(const ButtonEvent& ev)
+{
+    _stats.add(ButtonStats::Callbacks);
+    if (_latency) {
+        const int64_t entry = monotonicNs();
+        _latency->delivery.record(entry - static_cast<int64_t>(ev.ts_ns));
+        if (_evCb) {
+            _evCb(ev.rising, ev.ts_ns);
+            _latency->callback.record(monotonicNs() - entry);
+        }
+    } else if (_evCb) {
+        _evCb(ev.rising, ev.ts_ns);
+    }
+}
+
+void Button::_coalesceEdge(const ButtonEvent& ev)
+{
+    Coalescer& c = *_coalesce;
+    const int64_t ns = static_cast<int64_t>(ev.ts_ns);
+
+    // An edge past the deadline closes the window even if its timer has not fired yet
+    if (c.open.count && ns >= c.deadline_ns) flushCoalesced();
+
+    if (c.open.count == 0) {
+        c.open.first_ns = ev.ts_ns;
+        c.open.rising = 0;
+        c.open.line = _pin;
+        c.deadline_ns = ns + c.window_ns;
+        if (_group) _group->_coalesceWheel.schedule(c.timer, c.deadline_ns);
+    }
+    ++c.open.count;
+    if (ev.rising) ++c.open.rising;
+    c.open.last_ns = ev.ts_ns;
+    c.open.state = ev.rising;
+}
+
+void Button::_expireCoalesced(int64_t now_ns)
+{
+    if (_coalesce->deadline_ns >= 0 && now_ns >= _coalesce->deadline_ns) flushCoalesced();
+}
+
+void Button::_onCoalesceTimer(void* ctx)
+{
+    static_cast<Button*>(ctx)->flushCoalesced();
+}
+
+ButtonError Button::_startEventThread(void)
+{
+    _evWakeFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_evWakeFd < 0) return _fail(ButtonError::EventFd, errno);
+
+    if (_threadOpts.lockMemory && ::mlockall(MCL_CURRENT | MCL_FUTURE) < 0) {
+        _fail(ButtonError::MemoryLock, errno);
+        ::close(_evWakeFd);
+        _evWakeFd = -1;
+        return _lastError;
+    }
+
+    _waits.open(_evWakeFd);
+    _evWaitList.store(&_waits, std::memory_order_release);
+
+    _evRunning.store(true);
+    _evThread = std::thread(&Button::_eventLoop, this);
+
+    int err = 0;
+    const ButtonError e = _applyThreadOptions(_evThread, _threadOpts, err);
+    if (e != ButtonError::None) {
+        stopInterrupt();
+        return _fail(e, err);
+    }
+    return _fail(ButtonError::None);
+}
+
+void Button::_moveFrom(Button& o)
+{
+    // Quiesce every thread that may touch o: its group loop and its own event thread
+    ButtonGroup* group = o._group;
+    const bool groupRunning = group && group->_pause();
+
+    const bool ownThread = o._evRunning.load();
+    const bool threadless = !ownThread && !group && o._evWaitList.load() == &o._waits;
+    o.stopInterrupt();      // also completes o's pending awaits
+
+    errorMessage = std::move(o.errorMessage);
+    _auxi = std::move(o._auxi);
+    _lastError = o._lastError;
+    _lastErrno = o._lastErrno;
+    _evGone.store(o._evGone.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    _chipPath = std::move(o._chipPath);
+    _pin = o._pin;
+    _mode = o._mode;
+    _bias = o._bias;
+
+    // Line ownership: the moved-from object must not release anything
+    _evChip = o._evChip;                    o._evChip = nullptr;
+    _evReq = std::move(o._evReq);
+    _evPolled = o._evPolled;                o._evPolled = false;
+    _evEdge = o._evEdge;
+    _evDebouncer = o._evDebouncer;          o._evDebouncer = nullptr;
+    _evDebounceId = o._evDebounceId;
+    _debounceMode = o._debounceMode;
+    _evClock = o._evClock;
+    _evCb = o._evCb;
+    _evDebounce_us = o._evDebounce_us;
+    _evLast_ns = o._evLast_ns;
+    _evStateSeq.store(o._evStateSeq.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    _queue = std::move(o._queue);
+    _trace = o._trace;                      o._trace = nullptr;
+    _traceChip = o._traceChip;
+    _stats.transfer(o._stats);
+    _latency = std::move(o._latency);
+    _coalesce = std::move(o._coalesce);
+    if (_coalesce) _coalesce->timer.ctx = this;     // the node may still be linked in the group wheel
+    _threadOpts = o._threadOpts;
+    _group = nullptr;                       o._group = nullptr;
+    _chordBit = o._chordBit;                o._chordBit = -1;
+
+    // Resume whatever served o, now on this object
+    if (group) {
+        _evWaitList.store(o._evWaitList.exchange(nullptr), std::memory_order_release);
+        group->_relocate(&o, this);
+        if (groupRunning) group->_resume();
+    }
+    else if (ownThread) {
+        _startEventThread();
+    }
+    else if (threadless) {
+        _waits.open(-1);
+        _evWaitList.store(&_waits, std::memory_order_release);
+    }
+}
+
+void Button::_eventLoop(void)
+{
+    _enterThread(_threadOpts);
+
+    pollfd fds[2];
+    fds[0].fd = _eventFd();
+    fds[0].events = POLLIN;
+    fds[1].fd = _evWakeFd;
+    fds[1].events = POLLIN;
+
+    while (_evRunning.load()) {
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+        int n = ::poll(fds, 2, eventTimeoutMs());
+        _stats.add(ButtonStats::Syscalls);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        _stats.add(ButtonStats::Wakeups);
+        if (fds[0].revents & POLLIN) _handleEvents();
+        if (fds[0].revents & (POLLHUP | POLLERR | POLLNVAL)) {
+            // Chip unplugged: stop polling the line, keep serving awaits and timers
+            _lineGone(static_cast<unsigned int>(fds[0].revents));
+            fds[0].fd = -1;
+        }
+        if (fds[1].revents & POLLIN) {
+            uint64_t cnt;
+            while (::read(_evWakeFd, &cnt, sizeof(cnt)) > 0) {}
+        }
+        if (_coalesce) _expireCoalesced(monotonicNs());
+        if (_waits.pending()) _waits.expire(monotonicNs());
+    }
+}
+
+ButtonError Button::_applyThreadOptions(std::thread& t, const ButtonThreadOptions& opts, int& err)
+{
+    const pthread_t h = t.native_handle();
+
+    if (opts.name) {
+        char name[16];
+        std::strncpy(name, opts.name, sizeof(name) - 1);
+        name[sizeof(name) - 1] = '\0';
+        int rc = ::pthread_setname_np(h, name);
+        if (rc != 0) {
+            err = rc;
+            return ButtonError::ThreadName;
+        }
+    }
+
+    if (opts.cpuMask) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu = 0; cpu < 64; ++cpu) {
+            if (opts.cpuMask & (1ULL << cpu)) CPU_SET(cpu, &set);
+        }
+        int rc = ::pthread_setaffinity_np(h, sizeof(set), &set);
+        if (rc != 0) {
+            err = rc;
+            return ButtonError::ThreadAffinity;
+        }
+    }
+
+    if (opts.policy != SCHED_OTHER || opts.priority != 0) {
+        sched_param sp{};
+        sp.sched_priority = opts.priority;
+        int rc = ::pthread_setschedparam(h, opts.policy, &sp);
+        if (rc != 0) {
+            err = rc;
+            return ButtonError::ThreadScheduling;
+        }
+    }
+    return ButtonError::None;
+}
+
+ButtonError Button::_fail(ButtonError e, int err)
+{
+    _lastError = e;
+    _lastErrno = err;
+    return e;
+}
+
+void Button::_lineGone(unsigned int revents)
+{
+    _evGone.store((revents & POLLHUP) ? ENODEV : EIO, std::memory_order_release);
+}
+
+bool Button::_report(ButtonError e)
+{
+    if (e == ButtonError::None) return true;
+    _formatError();
+    return false;
+}
+
+void Button::_formatError(void)
+{
+    if (_lastError == ButtonError::AuxiBegin) {
+        errorMessage = "AUXI begin() failed: " + _auxi->errorMessage;
+        return;
+    }
+
+    errorMessage = "Button: ";
+    errorMessage += buttonErrorMessage(_lastError);
+    switch (_lastError) {
+        case ButtonError::ChipOpen:
+            errorMessage += " " + _chipPath;
+            break;
+        case ButtonError::LineGet:
+        case ButtonError::LineRequest:
+        case ButtonError::KernelDebounce:
+        case ButtonError::EventClock:
+            errorMessage += " for line " + std::to_string(_pin);
+            break;
+        default:
+            break;
+    }
+    if (_lastErrno) {
+        errorMessage += ": ";
+        errorMessage += std::strerror(_lastErrno);
+    } else {
+        errorMessage += ".";
+    }
+}
+
+void Button::_prefaultStack(size_t bytes)
+{
+    if (bytes == 0) return;
+    volatile unsigned char* p = static_cast<volatile unsigned char*>(alloca(bytes));
+    for (size_t i = 0; i < bytes; i += 4096) p[i] = 0;
+    p[bytes - 1] = 0;
+}
+
+void Button::_enterThread(const ButtonThreadOptions& opts)
+{
+    // PR_SET_TIMERSLACK only applies to the calling thread
+    if (opts.timerSlack_ns) ::prctl(PR_SET_TIMERSLACK, static_cast<unsigned long>(opts.timerSlack_ns), 0, 0, 0);
+    _prefaultStack(opts.stackPrefault);
+}
+
+#if __cplusplus >= 202002L
+template <typename Result>
+Button::Awaiter<Result>::Awaiter(Button& btn, ButtonWaiter::Want want, uint32_t timeout_ms)
+: _ready(false)
+{
+    _w.btn = &btn;
+    _w.want = want;
+    if (timeout_ms) _w.deadline_ns = monotonicNs() + static_cast<int64_t>(timeout_ms) * 1000000LL;
+
+    if (want == ButtonWaiter::Release && !btn.get()) {
+        _ready = true;                          // already released
+    } else if (!btn._evWaitList.load(std::memory_order_acquire)) {
+        _ready = true;                          // no event loop would ever resume us
+        _w.timedOut = true;
+    }
+}
+
+template <typename Result>
+bool Button::Awaiter<Result>::await_suspend(std::coroutine_handle<> h)
+{
+    _w.ctx = h.address();
+    _w.resume = &Awaiter::_resume;
+
+    ButtonWaitList* waits = _w.btn->_evWaitList.load(std::memory_order_acquire);
+    if (waits && waits->add(_w)) return true;
+
+    // Not registered: released meanwhile, or the loop stopped
+    _w.timedOut = !(_w.want == ButtonWaiter::Release && !_w.btn->get());
     return false;
 }
 
+template <>
+ButtonEvent Button::Awaiter<ButtonEvent>::await_resume(void) const noexcept
+{
+    if (_w.timedOut) return ButtonEvent::make(_w.btn->get(), _w.btn->_pin, 0);
+    return _w.ev;
+}
 
+template <>
+bool Button::Awaiter<bool>::await_resume(void) const noexcept
+{
+    return !_w.timedOut;
+}
 
+template <typename Result>
+void Button::Awaiter<Result>::_resume(ButtonWaiter* w)
+{
+    std::coroutine_handle<>::from_address(w->ctx).resume();
+}
+
+template class Button::Awaiter<ButtonEvent>;
+template class Button::Awaiter<bool>;
+
+Button::Awaiter<ButtonEvent> Button::nextEdge(void)
+{
+    return Awaiter<ButtonEvent>(*this, ButtonWaiter::AnyEdge, 0);
+}
+
+Button::Awaiter<bool> Button::nextPress(uint32_t timeout_ms)
+{
+    return Awaiter<bool>(*this, ButtonWaiter::Press, timeout_ms);
+}
+
+Button::Awaiter<bool> Button::waitReleased(uint32_t timeout_ms)
+{
+    return Awaiter<bool>(*this, ButtonWaiter::Release, timeout_ms);
+}
+#endif
+
+// ####################################################################
+// ResetButton class:
+
+bool ResetButton::begin(uint32_t debounce_us)
+{
+    // Hold time compares edge timestamps with CLOCK_MONOTONIC: keep both on one clock
+    setEventClock(EventClock::Monotonic);
+    enableEventQueue(64);
+    if (!beginInterrupt(AUXI::Edge::Both, debounce_us, nullptr)) return false;
+
+    // A button already held at startup has no press edge: time it from now
+    _held = get();
+    _press_ns = monotonicNs();
+    _countdown = 0;
+    _overflows = eventOverflows();
+    _action = Action::None;
+    return true;
+}
+
+void ResetButton::setThresholds(uint32_t reboot_ms, uint32_t shutdown_ms)
+{
+    _reboot_ms = reboot_ms;
+    _shutdown_ms = shutdown_ms;
+}
+
+void ResetButton::setCountdownCallback(CountdownCallback cb, void* user)
+{
+    _countdownCb = cb;
+    _countdownUser = user;
+}
+
+void ResetButton::setActionCallback(ActionCallback cb, void* user)
+{
+    _actionCb = cb;
+    _actionUser = user;
+}
+
+ResetButton::Action ResetButton::action(void) const
+{
+    return _action;
+}
+
+bool ResetButton::check()
+{
+    if (_action != Action::None) return false;
+
+    ButtonEvent evs[16];
+    size_t n;
+    while ((n = pollEvents(evs, 16)) > 0) {
+        for (size_t i = 0; i < n && _action == Action::None; ++i) {
+            const int64_t ns = static_cast<int64_t>(evs[i].ts_ns);
+            if (evs[i].rising) {
+                if (!_held) {
+                    _held = true;
+                    _press_ns = ns;
+                    _countdown = 0;
+                }
+            }
+            else if (_held) {
+                _held = false;
+                const int64_t held_ms = (ns - _press_ns) / 1000000LL;
+                if (held_ms >= static_cast<int64_t>(_shutdown_ms)) _fire(Action::Shutdown);
+                else if (held_ms >= static_cast<int64_t>(_reboot_ms)) _fire(Action::Reboot);
+            }
+        }
+    }
+
+    if (_action != Action::None) return _held;
+
+    // A full queue dropped edges, possibly the release: the timed press is void
+    const uint64_t overflows = eventOverflows();
+    if (overflows != _overflows) {
+        _overflows = overflows;
+        if (_held) {
+            _held = false;
+            _countdown = 0;
+            return false;
+        }
+    }
+    if (!_held) return false;
+
+    const int64_t held_ms = (monotonicNs() - _press_ns) / 1000000LL;
+
+    // Seconds left, rounded up: 3..2..1 for the default 4 s threshold after the first second
+    const bool due = held_ms >= static_cast<int64_t>(_shutdown_ms);
+    const unsigned int left = due ? 0 : static_cast<unsigned int>((static_cast<int64_t>(_shutdown_ms) - held_ms + 999) / 1000);
+    if (!due && left == _countdown) return true;
+
+    if (due) {
+        _fire(Action::Shutdown);
+        return true;
+    }
+    _countdown = left;
+    if (_countdownCb) _countdownCb(_countdownUser, left);
+    return true;
+}
+
+void ResetButton::_fire(Action a)
+{
+    _action = a;
+    if (_actionCb) {
+        _actionCb(_actionUser, a);
+        return;
+    }
+    if (a == Action::Shutdown) std::system("sudo /sbin/shutdown -h now");
+    else if (a == Action::Reboot) std::system("sudo /sbin/reboot");
+}
@@ -1,16 +1,28 @@
 /**
  * @file Button.h
- * @brief High-level push-button wrapper built on AUXIO::AUXI (libgpiod v1.x).
+ * @brief High-level push-button wrapper built on AUXIO::AUXI (libgpiod v1.x) or a selected line backend.
  *
  * This wrapper provides:
- *  - Simple configuration of a GPIO input line via AUXI
+ *  - Simple configuration of a GPIO input line (ButtonInput, on the shared chip of ButtonChipCache)
  *  - Polarity control (mode: active-high/active-low)
  *  - Bias control (bias: off / pull-down / pull-up)
  *  - Polling & cached reads:
  *      - value() -> RAW line level (0/1/-1)
  *      - read()  -> LOGICAL (polarity-applied) boolean
  *      - get()   -> cached LOGICAL boolean (no hardware access)
- *  - Event-driven interrupts with software debounce and a C-style callback
+ *  - Event-driven interrupts with software debounce and a C-style callback,
+ *    context callback, bound member function or small capturing lambda
+ *  - Shared-thread event dispatch for many buttons through ButtonGroup
+ *  - Optional lock-free event queue drained by the application (pollEvents())
+ *  - Kernel-side debounce (GPIO uAPI v2) with software fallback
+ *  - Optional edge-to-callback and callback-duration latency histograms
+ *  - Always-on per-button work counters (stats()): edges, bounces, callbacks, wakeups, syscalls
+ *  - Real-time event thread options (scheduling, CPU affinity, memory locking, name)
+ *  - Raw edge tracing to a memory-mapped ring file (ButtonTrace.h), replayable by ButtonReplay
+ *  - Allocation-free error codes (try*() / lastError()) next to errorMessage
+ *  - C++20 awaitables (nextEdge(), nextPress(), waitReleased()) resumed by the event loop
+ *  - Compile-time GPIO backend (libgpiod v1, libgpiod v2 or raw uAPI; ButtonBackend.h)
+ *  - Coalesced dispatch for fast pulse inputs: one summary callback per time window
  *
  * A specialized ResetButton is also provided that triggers reboot or shutdown
  * depending on how long the button is held.
@@ -23,22 +35,203 @@
 // #################################################################################
 // Include libraries:
 
-#include "../AUXIO_Linux/AUXIO.h"      // uses AUXI from your latest AUXIO library
+#include "ButtonBackend.h"            // AUXI (AUXIO or ButtonInput), ButtonInput and the event line backend
+#include "ButtonDelegate.h"
+#include "ButtonError.h"
+#include "ButtonStats.h"
+#include "ButtonTrace.h"
+#include "LatencyHistogram.h"
+#include "SpscRing.h"
+#include "TimerWheel.h"
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <thread>
 #include <chrono>
+#include <climits>
+#include <mutex>
+#include <sched.h>
+#if __cplusplus >= 202002L
+#include <coroutine>
+#include <span>
+#endif
 
 // #################################################################################
 
+struct gpiod_chip;
+struct ButtonChip;
+
+class ButtonGroup;
+class ButtonBank;
+class DebounceEngine;
+class ButtonReplay;
+
+/**
+ * @brief One accepted (debounced) edge event, as stored in the Button event queue.
+ *
+ * `ts_ns` is the timestamp the pipeline works with; `sec`/`nsec` are the same
+ * value split for the legacy API. Build events with make() so all three agree.
+ */
+struct ButtonEvent
+{
+    bool         rising;    ///< True for rising edge; false for falling edge
+    unsigned int line;      ///< GPIO line offset the event came from
+    long         sec;       ///< Timestamp seconds component
+    long         nsec;      ///< Timestamp nanoseconds component
+    uint64_t     ts_ns;     ///< Timestamp in ns of the event clock (Button::setEventClock())
+
+    /**
+     * @brief Event with all timestamp fields filled from @p ts_ns.
+     */
+    static constexpr ButtonEvent make(bool rising, unsigned int line, uint64_t ts_ns) noexcept
+    {
+        return ButtonEvent{rising, line, static_cast<long>(ts_ns / 1000000000ULL),
+                           static_cast<long>(ts_ns % 1000000000ULL), ts_ns};
+    }
+};
+
+/**
+ * @brief Every edge accepted during one coalescing window (Button::setCoalescing()).
+ *
+ * Timestamps are in the event clock, like ButtonEvent::ts_ns.
+ */
+struct ButtonEdgeSummary
+{
+    uint64_t     count;     ///< Accepted edges in the window (>= 1)
+    uint64_t     rising;    ///< Rising edges among them (count - rising were falling)
+    uint64_t     first_ns;  ///< Timestamp of the first edge
+    uint64_t     last_ns;   ///< Timestamp of the last edge
+    bool         state;     ///< LOGICAL state after the last edge
+    unsigned int line;      ///< GPIO line offset
+};
+
+/**
+ * @brief Coalesced dispatch callback: one call per window that saw at least one edge.
+ */
+using ButtonSummaryCallback = void(*)(void* user, const ButtonEdgeSummary& summary);
+
 /**
- * @brief GPIO edge event callback signature used by Button::beginInterrupt().
+ * @brief Scheduling and placement of an event thread (Button or ButtonGroup).
  *
- * @param is_rising True for rising edge; false for falling edge.
- * @param sec       Kernel timestamp seconds component.
- * @param nsec      Kernel timestamp nanoseconds component.
+ * Applied when the thread is started. Real-time policies and mlockall()
+ * usually need root or CAP_SYS_NICE / CAP_IPC_LOCK (or matching rlimits).
  */
-using GpioCallback = void(*)(bool is_rising, long sec, long nsec);
+struct ButtonThreadOptions
+{
+    int         policy = SCHED_OTHER;   ///< SCHED_OTHER (default), SCHED_FIFO or SCHED_RR
+    int         priority = 0;           ///< Static priority (1..99 for SCHED_FIFO/SCHED_RR)
+    uint64_t    cpuMask = 0;            ///< CPUs to pin to (bit n = CPU n); 0 = no pinning
+    bool        lockMemory = false;     ///< mlockall(MCL_CURRENT | MCL_FUTURE) before starting
+    size_t      stackPrefault = 0;      ///< Bytes of thread stack to touch at startup (avoid page faults later)
+    const char* name = nullptr;         ///< Thread name (max 15 chars), nullptr = unchanged
+    uint64_t    timerSlack_ns = 0;      ///< Timer slack (PR_SET_TIMERSLACK), 0 = kernel default (50 µs);
+                                        ///< larger values let loop timeouts coalesce with other wakeups
+};
+
+// #################################################################################
+// ButtonWaitList class:
+
+class Button;
+
+/**
+ * @brief One pending wait on a Button edge (intrusive; lives in the waiting frame).
+ */
+struct ButtonWaiter
+{
+    /**
+     * @brief Which dispatched edge completes the wait.
+     */
+    enum Want : uint8_t
+    {
+        AnyEdge,                ///< Any accepted edge
+        Press,                  ///< Rising LOGICAL edge
+        Release                 ///< Falling LOGICAL edge
+    };
+
+    Button*       btn = nullptr;            ///< Button waited on
+    void        (*resume)(ButtonWaiter*) = nullptr; ///< Completion hook, called without locks held
+    void*         ctx = nullptr;            ///< Hook context (e.g. coroutine handle address)
+    ButtonWaiter* next = nullptr;           ///< Intrusive list link
+    int64_t       deadline_ns = INT64_MAX;  ///< CLOCK_MONOTONIC deadline, INT64_MAX = none
+    ButtonEvent   ev{};                     ///< Completing edge (valid unless timedOut)
+    Want          want = AnyEdge;           ///< Completion condition
+    bool          timedOut = false;         ///< Completed by deadline or stop instead of an edge
+};
+
+/**
+ * @brief Pending waits served by one event loop (Button thread or ButtonGroup thread).
+ *
+ * The loop completes waits from _dispatch() and expires deadlines between
+ * wakeups; add() pokes the loop's wake fd when it brings a deadline forward.
+ * Dispatch only takes the lock while at least one wait is pending.
+ */
+class ButtonWaitList
+{
+    public:
+
+        /**
+         * @brief Accept waits; @p wakeFd is written when a new deadline is earlier (-1 = none).
+         */
+        void open(int wakeFd);
+
+        /**
+         * @brief Refuse new waits and complete all pending ones as timed out.
+         */
+        void close(void);
+
+        /**
+         * @brief Register a wait.
+         * @return false if the list is closed or the wait is already satisfied (not registered).
+         */
+        bool add(ButtonWaiter& w);
+
+        /**
+         * @brief True if at least one wait is pending (one atomic load).
+         */
+        bool pending(void) const { return _pending.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Complete the waits of @p btn matching @p ev.
+         */
+        void complete(Button* btn, const ButtonEvent& ev);
+
+        /**
+         * @brief Complete every wait whose deadline is at or before @p now_ns as timed out.
+         */
+        void expire(int64_t now_ns);
+
+        /**
+         * @brief Point the pending waits of @p from at @p to (Button move; waits stay pending).
+         */
+        void retarget(Button* from, Button* to);
+
+        /**
+         * @brief Complete the pending waits of @p btn as timed out (button leaves the loop).
+         */
+        void drop(Button* btn);
+
+        /**
+         * @brief Poll timeout in ms until the earliest deadline (-1 if none).
+         */
+        int timeoutMs(int64_t now_ns) const;
+
+    private:
+
+        std::mutex            _lock;                    ///< Guards the list and _open
+        ButtonWaiter*         _head = nullptr;          ///< Pending waits, FIFO
+        ButtonWaiter*         _tail = nullptr;          ///< Last pending wait
+        bool                  _open = false;            ///< Accepting new waits
+        int                   _wakeFd = -1;             ///< Wake fd of the serving loop
+        std::atomic<bool>     _pending{false};          ///< _head != nullptr
+        std::atomic<int64_t>  _deadline_ns{INT64_MAX};  ///< Earliest pending deadline
+
+        /**
+         * @brief Unlink the waits selected by @p pick (lock held) and resume them (lock released).
+         */
+        template <typename Pick>
+        void _take(Pick pick);
+};
 
 // #################################################################################
 // Button class:
@@ -63,8 +256,30 @@ class Button
 {
     public:
 
+        /**
+         * @brief Where the debounce window of beginInterrupt() is applied.
+         */
+        enum class Debounce : uint8_t
+        {
+            Software,   ///< User-space debounce on every kernel edge (default)
+            Kernel,     ///< Kernel debounce period (GPIO uAPI v2); fail if unsupported
+            Auto        ///< Kernel debounce if supported, otherwise software
+        };
+
+        /**
+         * @brief Clock of the kernel edge timestamps (ButtonEventClock).
+         *
+         * Monotonic is the default and what debounce, gestures, awaits and
+         * latency stats assume; Realtime gives wall-clock time, comparable
+         * across hosts; Hte needs a supporting SoC.
+         */
+        using EventClock = ButtonEventClock;
+
         /**
          * @brief Stores last error message (set if an operation fails).
+         *
+         * Filled by the bool-returning API only; the try*() variants record
+         * lastError()/lastErrno() without building a string.
          */
         std::string errorMessage;
         
@@ -78,6 +293,32 @@ class Button
          */
         Button(const char* gpiodChip_path, unsigned int pin, uint8_t mode = 1, uint8_t bias = 0);
 
+        Button(const Button&) = delete;
+        Button& operator=(const Button&) = delete;
+
+        /**
+         * @brief Take over @p other's line, event path and group registration.
+         *
+         * Requested lines, chip handles and the kernel event FIFO are handed
+         * over as they are (nothing is reopened, no edge is lost). A running
+         * event thread is stopped on @p other and restarted on this object, and
+         * awaits pending on it complete as timed out. The loop of a ButtonGroup
+         * serving @p other is only paused while the group is re-pointed: its
+         * awaits, chord holds and debounce windows carry over to this object.
+         *
+         * @note Not while attached to a ButtonReplay or a standalone ButtonBank,
+         *       and not from inside one of the button's callbacks. A callback
+         *       bound to @p other itself has to be re-bound by the caller.
+         *       @p other may afterwards only be destroyed or assigned to.
+         */
+        Button(Button&& other);
+
+        /**
+         * @brief Release this button (leaving its ButtonGroup), then take over @p other.
+         * @see Button(Button&&)
+         */
+        Button& operator=(Button&& other);
+
         /**
          * @brief Request the line as input with configured bias/polarity.
          * @return true on success, false on failure (see @ref errorMessage).
@@ -87,38 +328,309 @@ class Button
         /**
          * @brief Start edge-driven interrupts (numeric edge selector).
          *
-         * Requests kernel edge events and launches AUXI’s internal poll thread
-         * with optional software debounce. The callback is invoked from that thread.
+         * Requests kernel edge events and launches an event thread owned by this
+         * Button with optional software debounce. The callback is invoked from
+         * that thread; accepted edges are also pushed to the event queue if
+         * enabled (see @ref enableEventQueue()).
          *
          * @param edge         0=Both edges, 1=Rising only, 2=Falling only.
          * @param debounce_us  Debounce window in microseconds (default 5000).
-         * @param cb           C-style callback pointer (must not be null).
+         * @param cb           Callback: C-style pointer, bound member or small lambda
+         *                     (may be empty only if the event queue is enabled).
          * @return true on success, false on error (see errorMessage).
          */
-        bool beginInterrupt(uint8_t edge = 0, uint32_t debounce_us = 5000, GpioCallback cb = nullptr);
+        bool beginInterrupt(uint8_t edge = 0, uint32_t debounce_us = 5000, ButtonDelegate cb = nullptr);
 
         /**
          * @brief Start edge-driven interrupts (type-safe overload).
          *
          * @param edge         Edge selection (AUXI::Edge::Both/Rising/Falling).
          * @param debounce_us  Debounce window in microseconds.
-         * @param cb           C-style callback pointer (must not be null).
+         * @param cb           Callback: C-style pointer, bound member or small lambda
+         *                     (may be empty only if the event queue is enabled).
+         * @return true on success, false on error (see errorMessage).
+         */
+        bool beginInterrupt(AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb);
+
+        /**
+         * @brief Start edge-driven interrupts with a context-pointer callback.
+         *
+         * @param edge         Edge selection (AUXI::Edge::Both/Rising/Falling).
+         * @param debounce_us  Debounce window in microseconds.
+         * @param cb           Callback receiving @p user as first argument (must not be null).
+         * @param user         Opaque context pointer passed back to @p cb.
+         * @return true on success, false on error (see errorMessage).
+         */
+        bool beginInterrupt(AUXI::Edge edge, uint32_t debounce_us, GpioUserCallback cb, void* user);
+
+        /**
+         * @brief Start edge events without an event thread (numeric edge selector).
+         *
+         * For applications that already run an epoll/io_uring reactor: the
+         * line is requested exactly as for beginInterrupt(), but no thread is
+         * started. Register eventFd() for readability in your own loop and
+         * call processPendingEvents() when it fires; debounce, queueing and the
+         * callback then run on that thread.
+         *
+         * @param edge         0=Both edges, 1=Rising only, 2=Falling only.
+         * @param debounce_us  Debounce window in microseconds (default 5000).
+         * @param cb           Callback (may be empty only if the event queue is enabled).
          * @return true on success, false on error (see errorMessage).
          */
-        bool beginInterrupt(AUXI::Edge edge, uint32_t debounce_us, GpioCallback cb);
+        bool beginEvents(uint8_t edge = 0, uint32_t debounce_us = 5000, ButtonDelegate cb = nullptr);
+
+        /**
+         * @brief Start edge events without an event thread (type-safe overload).
+         * @see beginEvents(uint8_t, uint32_t, ButtonDelegate)
+         */
+        bool beginEvents(AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb);
+
+        /**
+         * @brief Readable file descriptor of the event line (-1 if no events are requested).
+         *
+         * Non-blocking; becomes readable (EPOLLIN/POLLIN) when kernel edges are
+         * queued. Owned by the Button: do not close it or read from it.
+         */
+        int eventFd(void) const;
+
+        /**
+         * @brief Drain, debounce and dispatch all queued edges without blocking.
+         *
+         * Call from the external loop when eventFd() is readable (extra calls
+         * are harmless). Also expires timed-out awaits of a beginEvents() Button.
+         * Must not be called on a Button served by its own thread or a ButtonGroup.
+         *
+         * @return Number of kernel edges read (before debounce).
+         */
+        size_t processPendingEvents(void);
 
         /**
-         * @brief Stop AUXI’s internal event thread (no-op if not running).
+         * @brief Poll timeout for the external loop until the next await or coalescing deadline (-1 if none).
+         */
+        int eventTimeoutMs(void) const;
+
+        /**
+         * @brief begin() without building errorMessage.
+         *
+         * Failure paths of the try*() functions never allocate in this library,
+         * so they suit tight retry loops (e.g. hot-plugged USB GPIO adapters).
+         * libgpiod and AUXI may still allocate internally.
+         *
+         * @return ButtonError::None on success, the failure code otherwise.
+         */
+        ButtonError tryBegin(void);
+
+        /**
+         * @brief beginInterrupt() without building errorMessage.
+         * @return ButtonError::None on success, the failure code otherwise.
+         */
+        ButtonError tryBeginInterrupt(AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb);
+
+        /**
+         * @brief beginEvents() without building errorMessage.
+         * @return ButtonError::None on success, the failure code otherwise.
+         */
+        ButtonError tryBeginEvents(AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb);
+
+        /**
+         * @brief Code of the last begin*() / tryBegin*() call (ButtonError::None after success).
+         *
+         * ButtonError::LineGone once the loop serving the line (event thread
+         * or ButtonGroup) saw the event fd hang up or fail; that loop no
+         * longer polls the line. The next begin*() clears it.
+         */
+        ButtonError lastError(void) const;
+
+        /**
+         * @brief errno of the system call behind lastError() (0 if none).
+         */
+        int lastErrno(void) const;
+
+        /**
+         * @brief Stop the Button’s event thread (no-op if not running).
+         *
+         * The event line stays requested, so read()/get() keep working.
+         * Pending awaits complete as timed out (also after beginEvents()).
          */
         void stopInterrupt();
 
+        /**
+         * @brief Select where debounce is applied for subsequent event requests.
+         *
+         * With Kernel/Auto the line is requested through the GPIO character
+         * device uAPI v2 with a debounce period attribute, so bounce edges are
+         * filtered before they wake user space. Must be called before
+         * beginInterrupt() or ButtonGroup::begin().
+         *
+         * @param mode Debounce placement (default Software).
+         */
+        void setDebounceMode(Debounce mode);
+
+        /**
+         * @brief True if the current event request is debounced by the kernel.
+         */
+        bool kernelDebounce(void) const;
+
+        /**
+         * @brief Select the clock of subsequent event requests.
+         *
+         * Realtime and Hte are requested through the GPIO uAPI v2 (the v1
+         * request has no clock flags); if the kernel or line refuses them,
+         * begin*() fails with ButtonError::EventClock. Must be called before
+         * beginInterrupt(), beginEvents() or ButtonGroup::begin().
+         *
+         * @note Only edge timestamps change. GestureEngine timers, await
+         *       deadlines, polled samples and delivery latency keep using
+         *       CLOCK_MONOTONIC, so use them with the Monotonic clock only.
+         *       ResetButton::begin() always selects Monotonic.
+         *
+         * @param clock Timestamp source (default Monotonic).
+         */
+        void setEventClock(EventClock clock);
+
+        /**
+         * @brief Clock selected for event requests.
+         */
+        EventClock eventClock(void) const;
+
+        /**
+         * @brief Collapse accepted edges into one callback per time window.
+         *
+         * Meant for fast pulse inputs (flow meters, tachometers) where one
+         * callback per edge would saturate a core. The first accepted edge
+         * opens a window of @p window_us; when it closes, @p cb receives the
+         * edge count, first/last timestamps and final state. The callback rate
+         * is bounded by 1/window whatever the edge rate, and no edge is left
+         * out of the counts. The per-edge callback is not called (event queue,
+         * chords and awaits still see every edge).
+         *
+         * Windows close on the dispatching thread: the Button or ButtonGroup
+         * loop wakes for them, and a beginEvents() loop should poll with
+         * eventTimeoutMs(). Must be called before beginInterrupt(),
+         * beginEvents() or ButtonGroup::begin().
+         *
+         * @note Window deadlines assume CLOCK_MONOTONIC event timestamps.
+         *
+         * @param window_us Window length in µs (0 = per-edge dispatch, the default).
+         * @param cb        Summary callback (ignored if @p window_us is 0).
+         * @param user      Context passed to @p cb.
+         */
+        void setCoalescing(uint32_t window_us, ButtonSummaryCallback cb, void* user = nullptr);
+
+        /**
+         * @brief Deliver the open window now, if any (call from the dispatching thread, or while stopped).
+         */
+        void flushCoalesced(void);
+
+        /**
+         * @brief Set scheduling options for the event thread started by beginInterrupt().
+         *
+         * Takes effect on the next beginInterrupt(); if the options cannot be
+         * applied, beginInterrupt() fails and reports why in errorMessage.
+         *
+         * @param opts Policy/priority, CPU affinity, memory locking, stack prefault and name.
+         */
+        void setThreadOptions(const ButtonThreadOptions& opts);
+
+        /**
+         * @brief Enable the lock-free event queue filled by the event path.
+         *
+         * Every accepted edge is pushed as a @ref ButtonEvent into a bounded
+         * single-producer/single-consumer ring, to be drained with pollEvents()
+         * from one application thread. Must be called before beginInterrupt()
+         * or ButtonGroup::begin(); storage is allocated here, never on the hot path.
+         *
+         * @param capacity Queue capacity (rounded up to a power of two).
+         */
+        void enableEventQueue(size_t capacity = 256);
+
+        /**
+         * @brief Drain queued events (single consumer thread, lock-free).
+         * @param out Destination array.
+         * @param max Capacity of @p out.
+         * @return Number of events copied (0 if none or the queue is disabled).
+         */
+        size_t pollEvents(ButtonEvent* out, size_t max);
+
+#if __cplusplus >= 202002L
+        /**
+         * @brief Drain queued events into a span (single consumer thread, lock-free).
+         * @param out Destination span; on return it is shrunk to the events copied.
+         * @return Number of events copied.
+         */
+        size_t pollEvents(std::span<ButtonEvent>& out);
+#endif
+
+        /**
+         * @brief Number of events dropped because the queue was full.
+         */
+        uint64_t eventOverflows(void) const;
+
+        /**
+         * @brief Snapshot of the event path counters (any thread, no locks).
+         *
+         * Bounces are only visible to software debounce: edges the kernel
+         * debounces away (Debounce::Kernel) never reach the library.
+         * Syscalls count the calls the serving thread issued for this button
+         * only; the shared epoll_wait()/io_uring_enter() of a ButtonGroup and
+         * read()/value() calls from application threads are not attributed.
+         */
+        ButtonStatsSnapshot stats(void) const;
+
+        /**
+         * @brief Zero the event path counters (only while the event path is stopped).
+         */
+        void resetStats(void);
+
+        /**
+         * @brief Record every raw edge (before debounce) to @p rec.
+         *
+         * Costs one atomic add and one 16-byte store per edge on the event
+         * thread. One recorder may be shared by several buttons, also across
+         * chips: each record carries the chip index of the Button's path
+         * (buttonTraceChip()). Must be set before the event path starts; pass
+         * nullptr to stop recording.
+         *
+         * @param rec Open recorder (must outlive the Button's event path).
+         */
+        void setTraceRecorder(ButtonTraceRecorder* rec);
+
+        /**
+         * @brief Enable latency instrumentation of the event path.
+         *
+         * For every dispatched edge two durations are recorded into lock-free
+         * histograms: kernel event timestamp → callback entry (delivery), and
+         * callback entry → return (callback execution). Must be called before
+         * beginInterrupt() or ButtonGroup::begin().
+         *
+         * @note Delivery latency assumes CLOCK_MONOTONIC event timestamps
+         *       (the kernel default since Linux 5.7).
+         */
+        void enableLatencyStats(void);
+
+        /**
+         * @brief Kernel-timestamp-to-callback delay histogram (nullptr if not enabled).
+         */
+        const LatencyHistogram* deliveryLatency(void) const;
+
+        /**
+         * @brief Callback execution time histogram (nullptr if not enabled).
+         */
+        const LatencyHistogram* callbackLatency(void) const;
+
         /**
          * @brief Release the GPIO line/chip resources (safe to call multiple times).
          *
-         * Calls @ref stopInterrupt() and then AUXI::clean().
+         * Calls @ref stopInterrupt(), releases any event line owned by a
+         * ButtonGroup registration and then calls AUXI::clean().
          */
         void clean(void);
 
+        /**
+         * @brief Destructor. Leaves its ButtonGroup and releases the event line if one is still held.
+         */
+        ~Button();
+
         /**
          * @brief Read current RAW digital level from the line.
          * @return 1 if high, 0 if low, or -1 on error.
@@ -129,18 +641,324 @@ class Button
         /**
          * @brief Read current LOGICAL state (hardware read + polarity applied).
          * @return true if pressed (logically active), false otherwise.
+         * @note With the event path active this never updates get(), which follows the event stream.
          */
         bool read(void);
 
         /**
          * @brief Get the last cached LOGICAL state (no hardware access).
+         *
+         * While the event path is active (beginInterrupt() or ButtonGroup) the
+         * cache is updated by the event thread on every kernel edge and this
+         * is a single wait-free atomic load.
+         *
          * @return true if last known state was pressed, false otherwise.
          */
         bool get(void);
 
+        /**
+         * @brief Edge sequence number of the event path (wait-free load).
+         *
+         * Monotonically increases by one for every kernel edge the event path
+         * observes (including edges later rejected by debounce), so any change
+         * of the cached state also changes the sequence.
+         */
+        uint64_t sequence(void) const;
+
+        /**
+         * @brief True if at least one edge was observed since @p seq was read from sequence().
+         */
+        bool changedSince(uint64_t seq) const;
+
+#if __cplusplus >= 202002L
+        /**
+         * @brief Awaitable of nextEdge()/nextPress()/waitReleased().
+         *
+         * The coroutine is resumed directly on the thread running this
+         * Button's event loop (its own thread or the ButtonGroup thread), right
+         * after the edge is dispatched. If no event loop serves the Button the
+         * await completes at once as timed out.
+         */
+        template <typename Result>
+        class Awaiter
+        {
+            public:
+
+                Awaiter(Button& btn, ButtonWaiter::Want want, uint32_t timeout_ms);
+
+                bool await_ready(void) const noexcept { return _ready; }
+                bool await_suspend(std::coroutine_handle<> h);
+                Result await_resume(void) const noexcept;
+
+            private:
+
+                ButtonWaiter _w;            ///< Registered wait
+                bool         _ready;        ///< Complete without suspending
+
+                static void _resume(ButtonWaiter* w);
+        };
+
+        /**
+         * @brief co_await the next accepted edge (either direction).
+         * @return The edge (timestamp 0 if the event loop stopped).
+         */
+        Awaiter<ButtonEvent> nextEdge(void);
+
+        /**
+         * @brief co_await the next press.
+         * @param timeout_ms Give up after this many ms (0 = wait forever).
+         * @return true on press, false on timeout or stop.
+         */
+        Awaiter<bool> nextPress(uint32_t timeout_ms = 0);
+
+        /**
+         * @brief co_await release (completes at once if not pressed).
+         * @param timeout_ms Give up after this many ms (0 = wait forever).
+         * @return true once released, false on timeout or stop.
+         */
+        Awaiter<bool> waitReleased(uint32_t timeout_ms = 0);
+#endif
+
     protected:
 
-        AUXI        _auxi;          ///< Underlying AUXI instance (configured via constructor)
+        std::unique_ptr<ButtonInput> _auxi;     ///< Plain input line (heap: stays put when the Button moves)
+
+    private:
+
+        friend class ButtonGroup;
+        friend class ButtonBank;
+        friend class ButtonReplay;
+        friend class Encoder;
+
+        ButtonGroup* _group = nullptr;      ///< Group this button is registered in (nullptr = none)
+        int          _chordBit = -1;        ///< Bit in the group's chord mask (-1 = not in a chord)
+        ButtonError  _lastError = ButtonError::None;    ///< Code of the last begin*()
+        int          _lastErrno = 0;        ///< errno behind _lastError
+        std::atomic<int> _evGone{0};        ///< errno of a hung-up/failed event fd, set by the serving loop (0 = healthy)
+
+        std::string  _chipPath;             ///< GPIO chip path (kept for direct event requests)
+        unsigned int _pin;                  ///< GPIO line offset
+        uint8_t      _mode;                 ///< Polarity: 1=active-high, 0=active-low
+        uint8_t      _bias;                 ///< Bias: 0=off, 1=pull-down, 2=pull-up
+
+        ButtonChip*  _evChip = nullptr;     ///< Shared chip of the direct event request (ButtonChipCache)
+        ButtonLineBackend _evReq;           ///< Line requested for edge events (selected backend)
+        bool         _evPolled = false;                 ///< True while sampled by a ButtonGroup poller
+        AUXI::Edge   _evEdge = AUXI::Edge::Both;        ///< Edge selection of the event path
+        DebounceEngine* _evDebouncer = nullptr;         ///< Shared group debouncer (replaces the window)
+        uint32_t     _evDebounceId = 0;                 ///< Input id in _evDebouncer
+        Debounce     _debounceMode = Debounce::Software; ///< Requested debounce placement
+        EventClock   _evClock = EventClock::Monotonic;  ///< Requested timestamp clock
+        ButtonDelegate _evCb;               ///< Callback dispatched for accepted edges
+        uint32_t     _evDebounce_us = 0;    ///< Software debounce window for the event path
+        int64_t      _evLast_ns = -1;       ///< Timestamp of the last accepted edge (-1 = none)
+        /**
+         * @brief Packed `sequence << 1 | logical state` of the event path.
+         *
+         * One atomic word on its own cache line, so get()/changedSince() are a
+         * single wait-free load and never share a line with event-thread data.
+         */
+        alignas(64) std::atomic<uint64_t> _evStateSeq{0};
+
+        std::unique_ptr<SpscRing<ButtonEvent>> _queue;  ///< Optional event queue (nullptr if disabled)
+        ButtonTraceRecorder* _trace = nullptr;          ///< Raw edge recorder (nullptr if disabled)
+        uint16_t     _traceChip = BUTTON_TRACE_NO_CHIP; ///< Chip index written to trace records
+        ButtonStats       _stats;                       ///< Event path counters
+
+        /**
+         * @brief Latency histograms of the event path.
+         */
+        struct LatencyStats
+        {
+            LatencyHistogram delivery;      ///< Kernel timestamp → callback entry
+            LatencyHistogram callback;      ///< Callback execution time
+        };
+        std::unique_ptr<LatencyStats> _latency;         ///< Optional instrumentation (nullptr if disabled)
+
+        /**
+         * @brief Coalesced dispatch state (setCoalescing()).
+         *
+         * Heap-allocated so the timer, linked into a ButtonGroup wheel, keeps
+         * its address when the Button is moved.
+         */
+        struct Coalescer
+        {
+            ButtonSummaryCallback cb = nullptr;     ///< Summary callback
+            void*             user = nullptr;       ///< Context of cb
+            int64_t           window_ns = 0;        ///< Window length
+            ButtonEdgeSummary open{};               ///< Window being filled (count 0 = none)
+            int64_t           deadline_ns = -1;     ///< Close time of the open window (-1 = none)
+            TimerWheel::Timer timer;                ///< Close timer while served by a ButtonGroup
+        };
+        std::unique_ptr<Coalescer> _coalesce;       ///< Optional coalesced dispatch (nullptr if disabled)
+
+        std::thread       _evThread;                ///< Event thread started by beginInterrupt()
+        ButtonThreadOptions _threadOpts;            ///< Options applied to _evThread
+        std::atomic<bool> _evRunning{false};        ///< Event thread run flag
+        int               _evWakeFd = -1;           ///< eventfd used to wake the event thread on stop
+        ButtonWaitList    _waits;                   ///< Waits served by _evThread
+        std::atomic<ButtonWaitList*> _evWaitList{nullptr};  ///< Wait list of the serving loop (nullptr = none)
+
+        /**
+         * @brief Request the line for edge events directly (no AUXI thread).
+         *
+         * Any line held by AUXI is released first. The resulting event fd is
+         * returned by @ref _eventFd() and drained by @ref _handleEvents().
+         */
+        bool _requestEvents(AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb);
+
+        /**
+         * @brief Release the direct event line and chip (no-op if not requested).
+         */
+        void _releaseEvents(void);
+
+        /**
+         * @brief True if a direct event request is held.
+         */
+        bool _eventsRequested(void) const;
+
+        /**
+         * @brief Read the LOGICAL value of the event line: 1/0, or -1 on error.
+         *
+         * Not counted: callable from any thread (the serving thread counts its own calls).
+         */
+        int _readEventLine(void);
+
+        /**
+         * @brief File descriptor of the direct event line, or -1 if not requested.
+         */
+        int _eventFd(void) const;
+
+        /**
+         * @brief Maximum kernel events read by one read() call on the event fd.
+         */
+        static constexpr unsigned int EVENT_BATCH = BUTTON_EVENT_BATCH;
+
+        /**
+         * @brief Drain every pending edge event (non-blocking), batch by batch.
+         *
+         * Each read() returns up to @ref EVENT_BATCH kernel events, which are
+         * passed to @ref _processBatch() together.
+         *
+         * @return Number of kernel edges read.
+         */
+        size_t _handleEvents(void);
+
+        /**
+         * @brief Parse @p bytes of raw kernel line events read from _eventFd() and process them.
+         *
+         * Used by readers that bypass the backend's own read (ButtonGroup
+         * io_uring backend); the record format is the backend's
+         * (`gpio_v2_line_event`, or `gpioevent_data` for a libgpiod v1 request).
+         */
+        void _processRaw(const void* data, size_t bytes);
+
+        /**
+         * @brief Bytes of @ref EVENT_BATCH raw kernel events of the current request format.
+         */
+        size_t _rawBatchBytes(void) const;
+
+        /**
+         * @brief Publish the state of a batch of raw kernel edges, then debounce and dispatch it.
+         */
+        void _processBatch(ButtonEvent* evs, size_t n);
+
+        /**
+         * @brief Debounce a batch of edges in place and dispatch the accepted ones.
+         */
+        void _debounceDispatch(ButtonEvent* evs, size_t n);
+
+        /**
+         * @brief Configure the event pipeline for polled operation (no line request).
+         */
+        void _beginPolled(AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb, bool state);
+
+        /**
+         * @brief Feed one polled level change (sampled at @p now_ns) into the event pipeline.
+         */
+        void _pollSample(bool state, int64_t now_ns);
+
+        /**
+         * @brief Publish a new cached state and advance the sequence by @p edges.
+         */
+        void _publishState(bool state, uint64_t edges);
+
+        /**
+         * @brief Deliver an accepted edge to the event queue and the callback (or the open window).
+         */
+        void _dispatch(const ButtonEvent& ev);
+
+        /**
+         * @brief Call the per-edge callback for @p ev (latency stats included).
+         */
+        void _callEdge(const ButtonEvent& ev);
+
+        /**
+         * @brief Add @p ev to the open window, closing an expired one first.
+         */
+        void _coalesceEdge(const ButtonEvent& ev);
+
+        /**
+         * @brief Close the open window if its deadline is at or before @p now_ns.
+         */
+        void _expireCoalesced(int64_t now_ns);
+
+        /**
+         * @brief TimerWheel callback closing the open window (ctx = Button*).
+         */
+        static void _onCoalesceTimer(void* ctx);
+
+        /**
+         * @brief Body of the event thread started by beginInterrupt().
+         */
+        void _eventLoop(void);
+
+        /**
+         * @brief Start the event thread on the requested line (wake fd, waits, thread options).
+         */
+        ButtonError _startEventThread(void);
+
+        /**
+         * @brief Move every member of @p o into this (released) object; see Button(Button&&).
+         */
+        void _moveFrom(Button& o);
+
+        /**
+         * @brief Record a failure code (no allocation) and return it.
+         */
+        ButtonError _fail(ButtonError e, int err = 0);
+
+        /**
+         * @brief Record from the serving loop that the event fd hung up or failed.
+         * @param revents poll() or epoll revents of the fd (POLLHUP = EPOLLHUP -> ENODEV, otherwise EIO).
+         */
+        void _lineGone(unsigned int revents);
+
+        /**
+         * @brief Build errorMessage from a failure code; true if @p e is None.
+         */
+        bool _report(ButtonError e);
+
+        /**
+         * @brief Format errorMessage from _lastError/_lastErrno (allocates).
+         */
+        void _formatError(void);
+
+        /**
+         * @brief Apply @p opts to a freshly started thread (policy, affinity, name, mlockall).
+         * @return ButtonError::None on success; the failing call's code with @p err = its error otherwise.
+         */
+        static ButtonError _applyThreadOptions(std::thread& t, const ButtonThreadOptions& opts, int& err);
+
+        /**
+         * @brief Touch @p bytes of the calling thread's stack so it is resident.
+         */
+        static void _prefaultStack(size_t bytes);
+
+        /**
+         * @brief Setup only a thread can do on itself: timer slack, then stack prefault.
+         */
+        static void _enterThread(const ButtonThreadOptions& opts);
 };
 
 // ################################################################################
@@ -148,33 +966,111 @@ class Button
 
 /**
  * @class ResetButton
- * @brief Button with reboot/shutdown behavior based on hold time.
+ * @brief Button with reboot/shutdown behavior based on hold time (non-blocking).
  *
  * Behavior:
- *  - If pressed: start a 3..2..1 countdown.
- *  - If still pressed after countdown: shutdown system.
- *  - If released before countdown ends: reboot system.
+ *  - If pressed: start a countdown (see setCountdownCallback()).
+ *  - If still pressed when the shutdown threshold is reached: shutdown system.
+ *  - If released before that (and after the reboot threshold): reboot system.
+ *
+ * Hold time is measured from the kernel timestamps of the press/release edges,
+ * delivered through the Button event queue. check() only drains that queue and
+ * compares against CLOCK_MONOTONIC, so it never sleeps and can be called from
+ * the host control loop on every tick. Only a release edge that survived
+ * debounce ends the hold, so a glitch on a held line cannot cancel it; if
+ * the queue overflowed (a release may have been dropped) the hold is
+ * cancelled instead of shutting the system down.
  */
 class ResetButton : public Button
 {
     public:
 
+        /**
+         * @brief Action decided by the hold-time state machine.
+         */
+        enum class Action : uint8_t
+        {
+            None,       ///< No action (yet)
+            Reboot,     ///< Released after the reboot threshold
+            Shutdown    ///< Held until the shutdown threshold
+        };
+
+        /**
+         * @brief Countdown callback: seconds left until shutdown while held (3, 2, 1, ...).
+         */
+        using CountdownCallback = void(*)(void* user, unsigned int seconds_left);
+
+        /**
+         * @brief Action callback. If none is set, the default runs reboot/shutdown via std::system().
+         */
+        using ActionCallback = void(*)(void* user, Action action);
+
         using Button::Button; // inherit constructors
 
+        ResetButton(ResetButton&&) = default;
+        ResetButton& operator=(ResetButton&&) = default;
+
         /**
-         * @brief Execute reboot/shutdown behavior.
+         * @brief Request both-edge events with the event queue enabled.
          *
-         * If pressed, prints a countdown (3..2..1). If still pressed
-         * after countdown, performs shutdown; otherwise, performs reboot.
+         * Always requests CLOCK_MONOTONIC timestamps: an earlier
+         * setEventClock() is overridden, since check() compares edge
+         * timestamps against CLOCK_MONOTONIC.
          *
-         * @return true if button was initially pressed, false otherwise.
-         * @note This call blocks while counting down and executing system calls.
+         * @param debounce_us Debounce window in microseconds (default 5000).
+         * @return true on success, false on failure (see @ref errorMessage).
          */
-        bool check(void);
+        bool begin(uint32_t debounce_us = 5000);
 
-};
+        /**
+         * @brief Set hold-time thresholds.
+         *
+         * @param reboot_ms   Minimum press length that triggers reboot on release (default 0).
+         * @param shutdown_ms Hold length that triggers shutdown (default 4000).
+         */
+        void setThresholds(uint32_t reboot_ms, uint32_t shutdown_ms);
 
+        /**
+         * @brief Set the countdown callback (nullptr disables it).
+         */
+        void setCountdownCallback(CountdownCallback cb, void* user = nullptr);
 
+        /**
+         * @brief Set the action callback (nullptr restores the default system reboot/shutdown).
+         */
+        void setActionCallback(ActionCallback cb, void* user = nullptr);
 
+        /**
+         * @brief Advance the reboot/shutdown state machine (non-blocking).
+         *
+         * Drains queued edges, emits countdown callbacks and fires the action
+         * once a threshold is met. Cheap enough to call on every loop tick.
+         *
+         * @return true while the button is held, false otherwise.
+         */
+        bool check(void);
 
+        /**
+         * @brief Action fired so far (Action::None until a threshold is met).
+         */
+        Action action(void) const;
 
+    private:
+
+        uint32_t            _reboot_ms = 0;             ///< Minimum press for reboot
+        uint32_t            _shutdown_ms = 4000;        ///< Hold time for shutdown
+        bool                _held = false;              ///< True while a press is being timed
+        int64_t             _press_ns = 0;              ///< Kernel timestamp of the press edge
+        unsigned int        _countdown = 0;             ///< Last countdown value reported
+        uint64_t            _overflows = 0;             ///< eventOverflows() seen by the last check()
+        Action              _action = Action::None;     ///< Action already fired
+        CountdownCallback   _countdownCb = nullptr;     ///< Countdown callback
+        void*               _countdownUser = nullptr;   ///< Countdown callback context
+        ActionCallback      _actionCb = nullptr;        ///< Action callback (nullptr = system())
+        void*               _actionUser = nullptr;      ///< Action callback context
+
+        /**
+         * @brief Fire @p a once, through the action callback or std::system().
+         */
+        void _fire(Action a);
+};
@@ -0,0 +1,119 @@
+/**
+ * @file ButtonBackend.h
+ * @brief Compile-time selection of the GPIO access layer behind Button.
+ *
+ * The edge event line of a Button is requested, read and released through a
+ * line backend chosen when the library is built:
+ *
+ *  - `BUTTON_BACKEND_GPIOD_V1` (default): libgpiod 1.x, with raw uAPI v2
+ *    requests for kernel debounce and non-monotonic event clocks; `AUXI`
+ *    (Edge) comes from AUXIO.
+ *  - `BUTTON_BACKEND_GPIOD_V2`: libgpiod 2.x (edge event buffers, debounce
+ *    and event clock in the line settings).
+ *  - `BUTTON_BACKEND_UAPI`: raw GPIO uAPI v2 ioctls, no libgpiod at all.
+ *
+ * Select with e.g. `-DBUTTON_BACKEND=BUTTON_BACKEND_UAPI` (the same value for
+ * every translation unit). The backend is a concrete member type, so every
+ * call on the event path is a direct, inlinable call: no virtual dispatch.
+ * With the v2 and uAPI backends, AUXIO is not used; `AUXI` then names
+ * ButtonInput, so application code (`AUXI::Edge::Both`, ...) is unchanged.
+ * Plain inputs (Button::begin()) are a ButtonInput in every backend, so
+ * they share the cached chip handle with the event lines.
+ *
+ * Every backend class provides the same members:
+ * @code
+ *   ButtonError request(ButtonChip* chip, const ButtonLineConfig& cfg, int& err);
+ *   void   release(void);
+ *   bool   requested(void) const;
+ *   int    fd(void) const;
+ *   bool   kernelDebounce(void) const;
+ *   int    value(void);                                            // LOGICAL 1/0, -1 on error
+ *   int    read(ButtonEvent* out, unsigned int max, unsigned int line);    // non-blocking, <= 0: none
+ *   size_t decode(const void* raw, size_t bytes, ButtonEvent* out, size_t max, unsigned int line) const;
+ *   size_t eventBytes(void) const;                                 // raw kernel record size
+ * @endcode
+ * and is movable but not copyable.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Backend selection:
+
+#define BUTTON_BACKEND_GPIOD_V1     1   ///< libgpiod 1.x (+ raw uAPI v2 for debounce/clock)
+#define BUTTON_BACKEND_GPIOD_V2     2   ///< libgpiod 2.x
+#define BUTTON_BACKEND_UAPI         3   ///< Raw GPIO uAPI v2 ioctls (no libgpiod)
+
+#ifndef BUTTON_BACKEND
+#define BUTTON_BACKEND BUTTON_BACKEND_GPIOD_V1
+#endif
+
+#if BUTTON_BACKEND != BUTTON_BACKEND_GPIOD_V1 && BUTTON_BACKEND != BUTTON_BACKEND_GPIOD_V2 && \
+    BUTTON_BACKEND != BUTTON_BACKEND_UAPI
+#error "BUTTON_BACKEND must be BUTTON_BACKEND_GPIOD_V1, BUTTON_BACKEND_GPIOD_V2 or BUTTON_BACKEND_UAPI"
+#endif
+
+// #################################################################################
+// Include libraries:
+
+#include "ButtonInput.h"               // plain inputs of every backend (shared chip)
+#if BUTTON_BACKEND == BUTTON_BACKEND_GPIOD_V1
+#include "../AUXIO_Linux/AUXIO.h"      // uses AUXI from your latest AUXIO library
+#else
+using AUXI = ButtonInput;              // AUXI::Edge without AUXIO / libgpiod 1.x
+#endif
+#include "ButtonError.h"
+#include <cstddef>
+#include <cstdint>
+
+struct ButtonChip;
+struct ButtonEvent;
+
+// #################################################################################
+// Line configuration:
+
+/**
+ * @brief Most kernel events read by one read() on an event fd (Button::EVENT_BATCH).
+ */
+constexpr unsigned int BUTTON_EVENT_BATCH = 16;
+
+/**
+ * @brief Clock of kernel edge timestamps (also Button::EventClock).
+ */
+enum class ButtonEventClock : uint8_t
+{
+    Monotonic,      ///< CLOCK_MONOTONIC (default)
+    Realtime,       ///< CLOCK_REALTIME (Linux >= 5.11)
+    Hte             ///< Hardware timestamp engine (Linux >= 5.19, provider needed)
+};
+
+/**
+ * @brief Everything a backend needs to request one line for edge events.
+ */
+struct ButtonLineConfig
+{
+    unsigned int     offset = 0;                        ///< Line offset on the chip
+    AUXI::Edge       edge = AUXI::Edge::Both;           ///< Edges to report
+    bool             activeLow = false;                 ///< Report LOGICAL levels/edges of an active-low line
+    uint8_t          bias = 0;                          ///< 0=off, 1=pull-down, 2=pull-up
+    uint32_t         debounce_us = 0;                   ///< Kernel debounce period (0 = none)
+    ButtonEventClock clock = ButtonEventClock::Monotonic;   ///< Timestamp clock
+    const char*      consumer = "Button";               ///< Consumer label shown by gpioinfo
+};
+
+// #################################################################################
+// Selected backend:
+
+#include "ButtonBackendUapi.h"
+
+#if BUTTON_BACKEND == BUTTON_BACKEND_GPIOD_V1
+#include "ButtonBackendGpiodV1.h"
+using ButtonLineBackend = ButtonBackendGpiodV1;
+#elif BUTTON_BACKEND == BUTTON_BACKEND_GPIOD_V2
+#include "ButtonBackendGpiodV2.h"
+using ButtonLineBackend = ButtonBackendGpiodV2;
+#else
+using ButtonLineBackend = ButtonBackendUapi;
+#endif
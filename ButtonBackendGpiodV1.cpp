@@ -0,0 +1,132 @@
+// #######################################################################
+// Include Libraries:
+
+#include "Button.h"
+
+#if BUTTON_BACKEND == BUTTON_BACKEND_GPIOD_V1
+
+#include "ButtonChip.h"
+#include <gpiod.h>
+#include <cerrno>
+#include <linux/gpio.h>
+
+// #######################################################################
+// ButtonBackendGpiodV1 class:
+
+ButtonBackendGpiodV1::ButtonBackendGpiodV1(ButtonBackendGpiodV1&& o) noexcept
+    : _line(o._line), _v2(std::move(o._v2))
+{
+    o._line = nullptr;
+}
+
+ButtonBackendGpiodV1& ButtonBackendGpiodV1::operator=(ButtonBackendGpiodV1&& o) noexcept
+{
+    if (this != &o) {
+        release();
+        _line = o._line;        o._line = nullptr;
+        _v2 = std::move(o._v2);
+    }
+    return *this;
+}
+
+ButtonBackendGpiodV1::~ButtonBackendGpiodV1()
+{
+    release();
+}
+
+ButtonError ButtonBackendGpiodV1::request(ButtonChip* chip, const ButtonLineConfig& cfg, int& err)
+{
+    release();
+
+    // Only the v2 request can carry a debounce period or select a clock other than CLOCK_MONOTONIC
+    if (cfg.debounce_us > 0 || cfg.clock != ButtonEventClock::Monotonic) return _v2.request(chip, cfg, err);
+
+    gpiod_chip* gchip = ButtonChipCache::gpiod(chip, err);
+    if (!gchip) return ButtonError::ChipOpen;
+
+    gpiod_line* line = gpiod_chip_get_line(gchip, cfg.offset);
+    if (!line) {
+        err = errno;
+        return ButtonError::LineGet;
+    }
+
+    gpiod_line_request_config req{};
+    req.consumer = cfg.consumer;
+    switch (cfg.edge) {
+        case AUXI::Edge::Rising:  req.request_type = GPIOD_LINE_REQUEST_EVENT_RISING_EDGE;  break;
+        case AUXI::Edge::Falling: req.request_type = GPIOD_LINE_REQUEST_EVENT_FALLING_EDGE; break;
+        default:                  req.request_type = GPIOD_LINE_REQUEST_EVENT_BOTH_EDGES;   break;
+    }
+    if (cfg.activeLow) req.flags |= GPIOD_LINE_REQUEST_FLAG_ACTIVE_LOW;
+    switch (cfg.bias) {
+        case 1:  req.flags |= GPIOD_LINE_REQUEST_FLAG_BIAS_PULL_DOWN; break;
+        case 2:  req.flags |= GPIOD_LINE_REQUEST_FLAG_BIAS_PULL_UP;   break;
+        default: req.flags |= GPIOD_LINE_REQUEST_FLAG_BIAS_DISABLE;   break;
+    }
+
+    // The line is not owned until the request succeeds: nothing to release on failure
+    if (gpiod_line_request(line, &req, 0) < 0) {
+        err = errno;
+        return ButtonError::LineRequest;
+    }
+    _line = line;
+    return ButtonError::None;
+}
+
+void ButtonBackendGpiodV1::release(void)
+{
+    if (_line) {
+        gpiod_line_release(_line);
+        _line = nullptr;
+    }
+    _v2.release();
+}
+
+int ButtonBackendGpiodV1::fd(void) const
+{
+    if (_v2.requested()) return _v2.fd();
+    return _line ? gpiod_line_event_get_fd(_line) : -1;
+}
+
+int ButtonBackendGpiodV1::value(void)
+{
+    if (_v2.requested()) return _v2.value();
+    return _line ? gpiod_line_get_value(_line) : -1;
+}
+
+int ButtonBackendGpiodV1::read(ButtonEvent* out, unsigned int max, unsigned int line)
+{
+    if (_v2.requested()) return _v2.read(out, max, line);
+
+    gpiod_line_event raw[BUTTON_EVENT_BATCH];
+    if (max > BUTTON_EVENT_BATCH) max = BUTTON_EVENT_BATCH;
+
+    const int n = gpiod_line_event_read_fd_multiple(fd(), raw, max);
+    for (int i = 0; i < n; ++i) {
+        out[i] = ButtonEvent::make(raw[i].event_type == GPIOD_LINE_EVENT_RISING_EDGE, line,
+                                   static_cast<uint64_t>(raw[i].ts.tv_sec) * 1000000000ULL +
+                                   static_cast<uint64_t>(raw[i].ts.tv_nsec));
+    }
+    return n;
+}
+
+size_t ButtonBackendGpiodV1::decode(const void* raw, size_t bytes, ButtonEvent* out, size_t max, unsigned int line) const
+{
+    if (_v2.requested()) return _v2.decode(raw, bytes, out, max, line);
+
+    // libgpiod v1 reads the uAPI v1 event records from the same fd
+    const gpioevent_data* evs = static_cast<const gpioevent_data*>(raw);
+    size_t n = bytes / sizeof(evs[0]);
+    if (n > max) n = max;
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = ButtonEvent::make(evs[i].id == GPIOEVENT_EVENT_RISING_EDGE, line, evs[i].timestamp);
+    }
+    return n;
+}
+
+size_t ButtonBackendGpiodV1::eventBytes(void) const
+{
+    return _v2.requested() ? _v2.eventBytes() : sizeof(gpioevent_data);
+}
+
+#endif
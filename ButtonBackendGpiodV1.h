@@ -0,0 +1,106 @@
+/**
+ * @file ButtonBackendGpiodV1.h
+ * @brief Line backend on libgpiod 1.x (BUTTON_BACKEND_GPIOD_V1, the default).
+ *
+ * Plain edge requests go through gpiod_line_request(). libgpiod 1.x cannot
+ * set a debounce period or an event clock, so requests that need either are
+ * made as a raw uAPI v2 request (ButtonBackendUapi) instead; every call then
+ * forwards to it.
+ *
+ * Include ButtonBackend.h (or Button.h), not this header.
+ */
+
+// ################################################################################
+
+#pragma once
+
+struct gpiod_line;
+
+// #################################################################################
+// ButtonBackendGpiodV1 class:
+
+/**
+ * @class ButtonBackendGpiodV1
+ * @brief One libgpiod v1 (or uAPI v2) line request for edge events.
+ */
+class ButtonBackendGpiodV1
+{
+    public:
+
+        ButtonBackendGpiodV1() = default;
+
+        ButtonBackendGpiodV1(const ButtonBackendGpiodV1&) = delete;
+        ButtonBackendGpiodV1& operator=(const ButtonBackendGpiodV1&) = delete;
+
+        /**
+         * @brief Take over @p o's request (@p o is left released).
+         */
+        ButtonBackendGpiodV1(ButtonBackendGpiodV1&& o) noexcept;
+
+        /**
+         * @brief Release the current request, then take over @p o's.
+         */
+        ButtonBackendGpiodV1& operator=(ButtonBackendGpiodV1&& o) noexcept;
+
+        /**
+         * @brief Destructor. Calls @ref release().
+         */
+        ~ButtonBackendGpiodV1();
+
+        /**
+         * @brief Request @p cfg.offset on @p chip (must stay acquired while requested).
+         *
+         * A debounce period or a non-monotonic clock selects the uAPI v2 request.
+         *
+         * @return ButtonError::None, or ChipOpen / LineGet / LineRequest /
+         *         KernelDebounce / EventClock with @p err = errno.
+         */
+        ButtonError request(ButtonChip* chip, const ButtonLineConfig& cfg, int& err);
+
+        /**
+         * @brief Release the line (no-op if none).
+         */
+        void release(void);
+
+        /**
+         * @brief True while a request is held.
+         */
+        bool requested(void) const { return _line != nullptr || _v2.requested(); }
+
+        /**
+         * @brief Line event fd, or -1.
+         */
+        int fd(void) const;
+
+        /**
+         * @brief True if the kernel debounces the current request.
+         */
+        bool kernelDebounce(void) const { return _v2.kernelDebounce(); }
+
+        /**
+         * @brief LOGICAL line value: 1/0, or -1 on error.
+         */
+        int value(void);
+
+        /**
+         * @brief Read up to @p max queued events (non-blocking fd): count, or <= 0 if none.
+         */
+        int read(ButtonEvent* out, unsigned int max, unsigned int line);
+
+        /**
+         * @brief Convert raw records read from fd() by the caller
+         *        (`gpioevent_data`, or `gpio_v2_line_event` for a v2 request).
+         * @return Number of events written to @p out.
+         */
+        size_t decode(const void* raw, size_t bytes, ButtonEvent* out, size_t max, unsigned int line) const;
+
+        /**
+         * @brief Size of one raw kernel record of the current request.
+         */
+        size_t eventBytes(void) const;
+
+    private:
+
+        gpiod_line*       _line = nullptr;  ///< libgpiod v1 line (nullptr if none)
+        ButtonBackendUapi _v2;              ///< uAPI v2 request (debounce / event clock)
+};
@@ -0,0 +1,151 @@
+// #######################################################################
+// Include Libraries:
+
+#include "Button.h"
+
+#if BUTTON_BACKEND == BUTTON_BACKEND_GPIOD_V2
+
+#include "ButtonChip.h"
+#include <gpiod.h>
+#include <cerrno>
+
+// #######################################################################
+// ButtonBackendGpiodV2 class:
+
+ButtonBackendGpiodV2::ButtonBackendGpiodV2(ButtonBackendGpiodV2&& o) noexcept
+    : _req(o._req), _buf(o._buf), _offset(o._offset), _debounce(o._debounce)
+{
+    o._req = nullptr;
+    o._buf = nullptr;
+    o._debounce = false;
+}
+
+ButtonBackendGpiodV2& ButtonBackendGpiodV2::operator=(ButtonBackendGpiodV2&& o) noexcept
+{
+    if (this != &o) {
+        release();
+        _req = o._req;              o._req = nullptr;
+        _buf = o._buf;              o._buf = nullptr;
+        _offset = o._offset;
+        _debounce = o._debounce;    o._debounce = false;
+    }
+    return *this;
+}
+
+ButtonBackendGpiodV2::~ButtonBackendGpiodV2()
+{
+    release();
+}
+
+ButtonError ButtonBackendGpiodV2::request(ButtonChip* chip, const ButtonLineConfig& cfg, int& err)
+{
+    release();
+
+    gpiod_chip* gchip = ButtonChipCache::gpiod(chip, err);
+    if (!gchip) return ButtonError::ChipOpen;
+
+    gpiod_line_settings* settings = gpiod_line_settings_new();
+    gpiod_line_config* lineCfg = gpiod_line_config_new();
+    gpiod_request_config* reqCfg = gpiod_request_config_new();
+    _buf = gpiod_edge_event_buffer_new(BUTTON_EVENT_BATCH);
+
+    ButtonError e = ButtonError::None;
+    if (!settings || !lineCfg || !reqCfg || !_buf) {
+        err = errno;
+        e = ButtonError::LineRequest;
+    }
+    else {
+        gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_INPUT);
+        switch (cfg.edge) {
+            case AUXI::Edge::Rising:  gpiod_line_settings_set_edge_detection(settings, GPIOD_LINE_EDGE_RISING);  break;
+            case AUXI::Edge::Falling: gpiod_line_settings_set_edge_detection(settings, GPIOD_LINE_EDGE_FALLING); break;
+            default:                  gpiod_line_settings_set_edge_detection(settings, GPIOD_LINE_EDGE_BOTH);    break;
+        }
+        switch (cfg.bias) {
+            case 1:  gpiod_line_settings_set_bias(settings, GPIOD_LINE_BIAS_PULL_DOWN); break;
+            case 2:  gpiod_line_settings_set_bias(settings, GPIOD_LINE_BIAS_PULL_UP);   break;
+            default: gpiod_line_settings_set_bias(settings, GPIOD_LINE_BIAS_DISABLED);  break;
+        }
+        switch (cfg.clock) {
+            case ButtonEventClock::Realtime: gpiod_line_settings_set_event_clock(settings, GPIOD_LINE_CLOCK_REALTIME);  break;
+            case ButtonEventClock::Hte:      gpiod_line_settings_set_event_clock(settings, GPIOD_LINE_CLOCK_HTE);       break;
+            default:                         gpiod_line_settings_set_event_clock(settings, GPIOD_LINE_CLOCK_MONOTONIC); break;
+        }
+        gpiod_line_settings_set_active_low(settings, cfg.activeLow);
+        gpiod_line_settings_set_debounce_period_us(settings, cfg.debounce_us);
+        gpiod_request_config_set_consumer(reqCfg, cfg.consumer);
+
+        const unsigned int offset = cfg.offset;
+        if (gpiod_line_config_add_line_settings(lineCfg, &offset, 1, settings) < 0) {
+            err = errno;
+            e = ButtonError::LineRequest;
+        }
+        else {
+            _req = gpiod_chip_request_lines(gchip, reqCfg, lineCfg);
+            if (!_req) {
+                err = errno;
+                if (cfg.debounce_us > 0) e = ButtonError::KernelDebounce;
+                else if (cfg.clock != ButtonEventClock::Monotonic) e = ButtonError::EventClock;
+                else e = ButtonError::LineRequest;
+            }
+        }
+    }
+
+    // The request keeps its own copy of the configuration
+    if (reqCfg) gpiod_request_config_free(reqCfg);
+    if (lineCfg) gpiod_line_config_free(lineCfg);
+    if (settings) gpiod_line_settings_free(settings);
+
+    if (e != ButtonError::None) {
+        release();
+        return e;
+    }
+    _offset = cfg.offset;
+    _debounce = cfg.debounce_us > 0;
+    return ButtonError::None;
+}
+
+void ButtonBackendGpiodV2::release(void)
+{
+    if (_req) {
+        gpiod_line_request_release(_req);
+        _req = nullptr;
+    }
+    if (_buf) {
+        gpiod_edge_event_buffer_free(_buf);
+        _buf = nullptr;
+    }
+    _debounce = false;
+}
+
+int ButtonBackendGpiodV2::fd(void) const
+{
+    return _req ? gpiod_line_request_get_fd(_req) : -1;
+}
+
+int ButtonBackendGpiodV2::value(void)
+{
+    if (!_req) return -1;
+    return static_cast<int>(gpiod_line_request_get_value(_req, _offset));    // ERROR is -1
+}
+
+int ButtonBackendGpiodV2::read(ButtonEvent* out, unsigned int max, unsigned int line)
+{
+    if (max > BUTTON_EVENT_BATCH) max = BUTTON_EVENT_BATCH;
+
+    const int n = gpiod_line_request_read_edge_events(_req, _buf, max);
+    for (int i = 0; i < n; ++i) {
+        gpiod_edge_event* ev = gpiod_edge_event_buffer_get_event(_buf, static_cast<unsigned long>(i));
+        out[i] = ButtonEvent::make(gpiod_edge_event_get_event_type(ev) == GPIOD_EDGE_EVENT_RISING_EDGE, line,
+                                   gpiod_edge_event_get_timestamp_ns(ev));
+    }
+    return n;
+}
+
+size_t ButtonBackendGpiodV2::decode(const void* raw, size_t bytes, ButtonEvent* out, size_t max, unsigned int line) const
+{
+    // libgpiod v2 requests are uAPI v2 requests: the fd yields gpio_v2_line_event records
+    return ButtonBackendUapi::decodeEvents(raw, bytes, out, max, line);
+}
+
+#endif
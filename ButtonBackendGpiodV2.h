@@ -0,0 +1,104 @@
+/**
+ * @file ButtonBackendGpiodV2.h
+ * @brief Line backend on libgpiod 2.x (BUTTON_BACKEND_GPIOD_V2).
+ *
+ * Edge detection, bias, polarity, kernel debounce and the event clock are
+ * all line settings of one gpiod_chip_request_lines() call. Events are read
+ * into an edge event buffer allocated once per request, so the event path
+ * does not allocate.
+ *
+ * Include ButtonBackend.h (or Button.h), not this header.
+ */
+
+// ################################################################################
+
+#pragma once
+
+struct gpiod_line_request;
+struct gpiod_edge_event_buffer;
+
+// #################################################################################
+// ButtonBackendGpiodV2 class:
+
+/**
+ * @class ButtonBackendGpiodV2
+ * @brief One libgpiod v2 line request for edge events.
+ */
+class ButtonBackendGpiodV2
+{
+    public:
+
+        ButtonBackendGpiodV2() = default;
+
+        ButtonBackendGpiodV2(const ButtonBackendGpiodV2&) = delete;
+        ButtonBackendGpiodV2& operator=(const ButtonBackendGpiodV2&) = delete;
+
+        /**
+         * @brief Take over @p o's request (@p o is left released).
+         */
+        ButtonBackendGpiodV2(ButtonBackendGpiodV2&& o) noexcept;
+
+        /**
+         * @brief Release the current request, then take over @p o's.
+         */
+        ButtonBackendGpiodV2& operator=(ButtonBackendGpiodV2&& o) noexcept;
+
+        /**
+         * @brief Destructor. Calls @ref release().
+         */
+        ~ButtonBackendGpiodV2();
+
+        /**
+         * @brief Request @p cfg.offset on @p chip (must stay acquired while requested).
+         * @return ButtonError::None, or ChipOpen / KernelDebounce / EventClock / LineRequest with @p err = errno.
+         */
+        ButtonError request(ButtonChip* chip, const ButtonLineConfig& cfg, int& err);
+
+        /**
+         * @brief Release the request and its event buffer (no-op if none).
+         */
+        void release(void);
+
+        /**
+         * @brief True while a request is held.
+         */
+        bool requested(void) const { return _req != nullptr; }
+
+        /**
+         * @brief Line request fd, or -1.
+         */
+        int fd(void) const;
+
+        /**
+         * @brief True if the kernel debounces the current request.
+         */
+        bool kernelDebounce(void) const { return _req != nullptr && _debounce; }
+
+        /**
+         * @brief LOGICAL line value: 1/0, or -1 on error.
+         */
+        int value(void);
+
+        /**
+         * @brief Read up to @p max queued events (non-blocking fd): count, or <= 0 if none.
+         */
+        int read(ButtonEvent* out, unsigned int max, unsigned int line);
+
+        /**
+         * @brief Convert raw `gpio_v2_line_event` records read from fd() by the caller.
+         * @return Number of events written to @p out.
+         */
+        size_t decode(const void* raw, size_t bytes, ButtonEvent* out, size_t max, unsigned int line) const;
+
+        /**
+         * @brief Size of one raw kernel record (`gpio_v2_line_event`).
+         */
+        size_t eventBytes(void) const { return ButtonBackendUapi::rawEventBytes(); }
+
+    private:
+
+        gpiod_line_request*      _req = nullptr;    ///< Line request (nullptr if none)
+        gpiod_edge_event_buffer* _buf = nullptr;    ///< BUTTON_EVENT_BATCH event buffer of _req
+        unsigned int             _offset = 0;       ///< Requested line offset
+        bool                     _debounce = false; ///< Request carries a kernel debounce period
+};
@@ -0,0 +1,142 @@
+// #######################################################################
+// Include Libraries:
+
+#include "Button.h"
+#include "ButtonChip.h"
+#include <cerrno>
+#include <cstring>
+#include <linux/gpio.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#ifndef GPIO_V2_LINE_FLAG_EVENT_CLOCK_REALTIME
+#define GPIO_V2_LINE_FLAG_EVENT_CLOCK_REALTIME  (1ULL << 11)   // Linux 5.11
+#endif
+#ifndef GPIO_V2_LINE_FLAG_EVENT_CLOCK_HTE
+#define GPIO_V2_LINE_FLAG_EVENT_CLOCK_HTE       (1ULL << 12)   // Linux 5.19
+#endif
+
+// #######################################################################
+// ButtonBackendUapi class:
+
+ButtonBackendUapi::ButtonBackendUapi(ButtonBackendUapi&& o) noexcept
+    : _fd(o._fd), _debounce(o._debounce)
+{
+    o._fd = -1;
+    o._debounce = false;
+}
+
+ButtonBackendUapi& ButtonBackendUapi::operator=(ButtonBackendUapi&& o) noexcept
+{
+    if (this != &o) {
+        release();
+        _fd = o._fd;            o._fd = -1;
+        _debounce = o._debounce; o._debounce = false;
+    }
+    return *this;
+}
+
+ButtonBackendUapi::~ButtonBackendUapi()
+{
+    release();
+}
+
+ButtonError ButtonBackendUapi::request(ButtonChip* chip, const ButtonLineConfig& cfg, int& err)
+{
+    release();
+
+    const int chipfd = ButtonChipCache::fd(chip, err);
+    if (chipfd < 0) return ButtonError::ChipOpen;
+
+    gpio_v2_line_request req{};
+    req.offsets[0] = cfg.offset;
+    req.num_lines = 1;
+    std::strncpy(req.consumer, cfg.consumer, sizeof(req.consumer) - 1);
+
+    uint64_t flags = GPIO_V2_LINE_FLAG_INPUT;
+    switch (cfg.edge) {
+        case AUXI::Edge::Rising:  flags |= GPIO_V2_LINE_FLAG_EDGE_RISING;  break;
+        case AUXI::Edge::Falling: flags |= GPIO_V2_LINE_FLAG_EDGE_FALLING; break;
+        default: flags |= GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING; break;
+    }
+    if (cfg.activeLow) flags |= GPIO_V2_LINE_FLAG_ACTIVE_LOW;
+    switch (cfg.bias) {
+        case 1:  flags |= GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN; break;
+        case 2:  flags |= GPIO_V2_LINE_FLAG_BIAS_PULL_UP;   break;
+        default: flags |= GPIO_V2_LINE_FLAG_BIAS_DISABLED;  break;
+    }
+    switch (cfg.clock) {
+        case ButtonEventClock::Realtime: flags |= GPIO_V2_LINE_FLAG_EVENT_CLOCK_REALTIME; break;
+        case ButtonEventClock::Hte:      flags |= GPIO_V2_LINE_FLAG_EVENT_CLOCK_HTE;      break;
+        default: break;
+    }
+    req.config.flags = flags;
+
+    if (cfg.debounce_us > 0) {
+        req.config.num_attrs = 1;
+        req.config.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_DEBOUNCE;
+        req.config.attrs[0].attr.debounce_period_us = cfg.debounce_us;
+        req.config.attrs[0].mask = 1;   // applies to line 0 of the request
+    }
+
+    if (::ioctl(chipfd, GPIO_V2_GET_LINE_IOCTL, &req) < 0) {
+        err = errno;
+        if (cfg.debounce_us > 0) return ButtonError::KernelDebounce;
+        if (cfg.clock != ButtonEventClock::Monotonic) return ButtonError::EventClock;
+        return ButtonError::LineRequest;
+    }
+
+    _fd = req.fd;
+    _debounce = cfg.debounce_us > 0;
+    return ButtonError::None;
+}
+
+void ButtonBackendUapi::release(void)
+{
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+    _debounce = false;
+}
+
+int ButtonBackendUapi::value(void)
+{
+    if (_fd < 0) return -1;
+
+    gpio_v2_line_values vals{};
+    vals.mask = 1;
+    if (::ioctl(_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &vals) < 0) return -1;
+    return static_cast<int>(vals.bits & 1);
+}
+
+int ButtonBackendUapi::read(ButtonEvent* out, unsigned int max, unsigned int line)
+{
+    gpio_v2_line_event raw[BUTTON_EVENT_BATCH];
+    if (max > BUTTON_EVENT_BATCH) max = BUTTON_EVENT_BATCH;
+
+    const ssize_t rd = ::read(_fd, raw, max * sizeof(raw[0]));
+    if (rd <= 0) return static_cast<int>(rd);
+    return static_cast<int>(decodeEvents(raw, static_cast<size_t>(rd), out, max, line));
+}
+
+size_t ButtonBackendUapi::decode(const void* raw, size_t bytes, ButtonEvent* out, size_t max, unsigned int line) const
+{
+    return decodeEvents(raw, bytes, out, max, line);
+}
+
+size_t ButtonBackendUapi::decodeEvents(const void* raw, size_t bytes, ButtonEvent* out, size_t max, unsigned int line)
+{
+    const gpio_v2_line_event* evs = static_cast<const gpio_v2_line_event*>(raw);
+    size_t n = bytes / sizeof(evs[0]);
+    if (n > max) n = max;
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = ButtonEvent::make(evs[i].id == GPIO_V2_LINE_EVENT_RISING_EDGE, line, evs[i].timestamp_ns);
+    }
+    return n;
+}
+
+size_t ButtonBackendUapi::rawEventBytes(void)
+{
+    return sizeof(gpio_v2_line_event);
+}
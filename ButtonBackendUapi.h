@@ -0,0 +1,109 @@
+/**
+ * @file ButtonBackendUapi.h
+ * @brief Line backend on raw GPIO uAPI v2 ioctls (BUTTON_BACKEND_UAPI).
+ *
+ * One GPIO_V2_GET_LINE_IOCTL request per line carries edge flags, bias,
+ * polarity, kernel debounce and the event clock; events are read straight
+ * from the request fd as `gpio_v2_line_event` records. Always built: the
+ * libgpiod v1 backend uses it for kernel debounce and event clocks.
+ *
+ * Include ButtonBackend.h (or Button.h), not this header.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// ButtonBackendUapi class:
+
+/**
+ * @class ButtonBackendUapi
+ * @brief One uAPI v2 line request for edge events.
+ */
+class ButtonBackendUapi
+{
+    public:
+
+        ButtonBackendUapi() = default;
+
+        ButtonBackendUapi(const ButtonBackendUapi&) = delete;
+        ButtonBackendUapi& operator=(const ButtonBackendUapi&) = delete;
+
+        /**
+         * @brief Take over @p o's request (@p o is left released).
+         */
+        ButtonBackendUapi(ButtonBackendUapi&& o) noexcept;
+
+        /**
+         * @brief Release the current request, then take over @p o's.
+         */
+        ButtonBackendUapi& operator=(ButtonBackendUapi&& o) noexcept;
+
+        /**
+         * @brief Destructor. Calls @ref release().
+         */
+        ~ButtonBackendUapi();
+
+        /**
+         * @brief Request @p cfg.offset on @p chip (must stay acquired while requested).
+         * @return ButtonError::None, or ChipOpen / KernelDebounce / EventClock / LineRequest with @p err = errno.
+         */
+        ButtonError request(ButtonChip* chip, const ButtonLineConfig& cfg, int& err);
+
+        /**
+         * @brief Close the request (no-op if none).
+         */
+        void release(void);
+
+        /**
+         * @brief True while a request is held.
+         */
+        bool requested(void) const { return _fd >= 0; }
+
+        /**
+         * @brief Line request fd, or -1.
+         */
+        int fd(void) const { return _fd; }
+
+        /**
+         * @brief True if the kernel debounces the current request.
+         */
+        bool kernelDebounce(void) const { return _fd >= 0 && _debounce; }
+
+        /**
+         * @brief LOGICAL line value: 1/0, or -1 on error.
+         */
+        int value(void);
+
+        /**
+         * @brief Read up to @p max queued events (non-blocking fd): count, or <= 0 if none.
+         */
+        int read(ButtonEvent* out, unsigned int max, unsigned int line);
+
+        /**
+         * @brief Convert raw records read from fd() by the caller.
+         * @return Number of events written to @p out.
+         */
+        size_t decode(const void* raw, size_t bytes, ButtonEvent* out, size_t max, unsigned int line) const;
+
+        /**
+         * @brief Size of one raw kernel record (`gpio_v2_line_event`).
+         */
+        size_t eventBytes(void) const { return rawEventBytes(); }
+
+        /**
+         * @brief decode() for any `gpio_v2_line_event` stream (also used by the libgpiod v2 backend).
+         */
+        static size_t decodeEvents(const void* raw, size_t bytes, ButtonEvent* out, size_t max, unsigned int line);
+
+        /**
+         * @brief sizeof(gpio_v2_line_event), without pulling linux/gpio.h into headers.
+         */
+        static size_t rawEventBytes(void);
+
+    private:
+
+        int     _fd = -1;               ///< Line request fd (-1 = none)
+        bool    _debounce = false;      ///< Request carries a kernel debounce period
+};
@@ -0,0 +1,237 @@
+// #######################################################################
+// Include Libraries:
+
+#include "ButtonBank.h"
+#include "ButtonChip.h"
+#if BUTTON_BACKEND == BUTTON_BACKEND_GPIOD_V1
+#include <gpiod.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <linux/gpio.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+// #######################################################################
+// ButtonBank class:
+
+ButtonBank::~ButtonBank()
+{
+    clean();
+}
+
+int ButtonBank::add(Button& btn)
+{
+    if (_requested()) {
+        errorMessage = "ButtonBank: cannot add buttons while begun.";
+        return -1;
+    }
+    if (_buttons.size() >= MAX_BUTTONS) {
+        errorMessage = "ButtonBank: too many buttons (max 64).";
+        return -1;
+    }
+    if (!_buttons.empty()) {
+        const Button& first = *_buttons.front();
+        if (btn._chipPath != first._chipPath) {
+            errorMessage = "ButtonBank: all buttons must be on " + first._chipPath + ".";
+            return -1;
+        }
+        if (btn._bias != first._bias) {
+            errorMessage = "ButtonBank: all buttons must use the same bias.";
+            return -1;
+        }
+    }
+    for (const Button* b : _buttons) {
+        if (b == &btn || b->_pin == btn._pin) {
+            errorMessage = "ButtonBank: line " + std::to_string(btn._pin) + " is already registered.";
+            return -1;
+        }
+    }
+
+    const int bit = static_cast<int>(_buttons.size());
+    _buttons.push_back(&btn);
+    _offsets.push_back(btn._pin);
+    if (btn._mode == 0) _invertMask |= (1ULL << bit);
+    return bit;
+}
+
+bool ButtonBank::begin(void)
+{
+    if (_requested()) return true;
+
+    if (_buttons.empty()) {
+        errorMessage = "ButtonBank: no buttons registered.";
+        return false;
+    }
+
+    // Lines can only be requested once: drop the buttons' own requests first
+    for (Button* b : _buttons) {
+        b->clean();
+    }
+
+    _chip = ButtonChipCache::acquire(_buttons.front()->_chipPath);
+    if (!_requestLines()) {
+        clean();
+        return false;
+    }
+
+    readMask();
+    return true;
+}
+
+void ButtonBank::clean(void)
+{
+#if BUTTON_BACKEND == BUTTON_BACKEND_GPIOD_V1
+    if (_bulk) {
+        gpiod_line_release_bulk(_bulk);
+        delete _bulk;
+        _bulk = nullptr;
+    }
+#else
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+#endif
+    if (_chip) {
+        ButtonChipCache::release(_chip);
+        _chip = nullptr;
+    }
+}
+
+uint64_t ButtonBank::readMask(bool* ok)
+{
+    if (ok) *ok = false;
+
+    uint64_t raw = 0;
+    if (!_readRaw(raw)) return _mask;
+
+    _mask = raw ^ _invertMask;     // apply polarity: active-low bits are inverted
+    if (ok) *ok = true;
+    return _mask;
+}
+
+uint64_t ButtonBank::getMask(void) const
+{
+    return _mask;
+}
+
+size_t ButtonBank::size(void) const
+{
+    return _buttons.size();
+}
+
+#if BUTTON_BACKEND == BUTTON_BACKEND_GPIOD_V1
+
+bool ButtonBank::_requested(void) const
+{
+    return _bulk != nullptr;
+}
+
+bool ButtonBank::_requestLines(void)
+{
+    const std::string& path = _chip->path;
+    int err = 0;
+    gpiod_chip* chip = ButtonChipCache::gpiod(_chip, err);
+    if (!chip) {
+        errorMessage = "ButtonBank: failed to open " + path + ".";
+        return false;
+    }
+
+    auto* bulk = new gpiod_line_bulk;
+    gpiod_line_bulk_init(bulk);
+    if (gpiod_chip_get_lines(chip, _offsets.data(), static_cast<unsigned int>(_offsets.size()), bulk) < 0) {
+        delete bulk;
+        errorMessage = "ButtonBank: failed to get lines on " + path + ".";
+        return false;
+    }
+
+    gpiod_line_request_config cfg{};
+    cfg.consumer = "ButtonBank";
+    cfg.request_type = GPIOD_LINE_REQUEST_DIRECTION_INPUT;
+    switch (_buttons.front()->_bias) {
+        case 1:  cfg.flags = GPIOD_LINE_REQUEST_FLAG_BIAS_PULL_DOWN; break;
+        case 2:  cfg.flags = GPIOD_LINE_REQUEST_FLAG_BIAS_PULL_UP;   break;
+        default: cfg.flags = GPIOD_LINE_REQUEST_FLAG_BIAS_DISABLE;   break;
+    }
+
+    if (gpiod_line_request_bulk(bulk, &cfg, nullptr) < 0) {
+        delete bulk;
+        errorMessage = "ButtonBank: bulk request failed on " + path + ".";
+        return false;
+    }
+
+    _bulk = bulk;
+    return true;
+}
+
+bool ButtonBank::_readRaw(uint64_t& raw)
+{
+    if (!_bulk) return false;
+
+    int values[MAX_BUTTONS];
+    if (gpiod_line_get_value_bulk(_bulk, values) < 0) return false;
+
+    raw = 0;
+    const size_t n = _buttons.size();
+    for (size_t i = 0; i < n; ++i) {
+        raw |= static_cast<uint64_t>(values[i] & 1) << i;
+    }
+    return true;
+}
+
+#else
+
+bool ButtonBank::_requested(void) const
+{
+    return _fd >= 0;
+}
+
+bool ButtonBank::_requestLines(void)
+{
+    const std::string& path = _chip->path;
+    int err = 0;
+    const int chipfd = ButtonChipCache::fd(_chip, err);
+    if (chipfd < 0) {
+        errorMessage = "ButtonBank: failed to open " + path + ".";
+        return false;
+    }
+
+    gpio_v2_line_request req{};
+    const size_t n = _offsets.size();
+    for (size_t i = 0; i < n; ++i) req.offsets[i] = _offsets[i];
+    req.num_lines = static_cast<uint32_t>(n);
+    std::strncpy(req.consumer, "ButtonBank", sizeof(req.consumer) - 1);
+
+    uint64_t flags = GPIO_V2_LINE_FLAG_INPUT;
+    switch (_buttons.front()->_bias) {
+        case 1:  flags |= GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN; break;
+        case 2:  flags |= GPIO_V2_LINE_FLAG_BIAS_PULL_UP;   break;
+        default: flags |= GPIO_V2_LINE_FLAG_BIAS_DISABLED;  break;
+    }
+    req.config.flags = flags;
+
+    if (::ioctl(chipfd, GPIO_V2_GET_LINE_IOCTL, &req) < 0) {
+        errorMessage = "ButtonBank: bulk request failed on " + path + ": " + std::strerror(errno);
+        return false;
+    }
+
+    _fd = req.fd;
+    return true;
+}
+
+bool ButtonBank::_readRaw(uint64_t& raw)
+{
+    if (_fd < 0) return false;
+
+    gpio_v2_line_values vals{};
+    const size_t n = _buttons.size();
+    vals.mask = (n >= 64) ? ~0ULL : ((1ULL << n) - 1);
+    if (::ioctl(_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &vals) < 0) return false;
+
+    raw = vals.bits & vals.mask;
+    return true;
+}
+
+#endif
@@ -0,0 +1,134 @@
+/**
+ * @file ButtonBank.h
+ * @brief Bulk input request for buttons on the same gpiochip (libgpiod v1 line bulk or uAPI v2).
+ *
+ * A ButtonBank requests the lines of up to 64 Button instances that live on
+ * the same `/dev/gpiochipN` with a single bulk line request. A full panel scan
+ * is then one GPIOHANDLE_GET_LINE_VALUES ioctl that returns every logical
+ * state as a bitmask, instead of one request and one ioctl per button.
+ * Outside BUTTON_BACKEND_GPIOD_V1 builds, the lines are one uAPI v2 request
+ * read with GPIO_V2_LINE_GET_VALUES_IOCTL.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Include libraries:
+
+#include "Button.h"
+#include <vector>
+
+struct gpiod_line_bulk;
+
+// #################################################################################
+// ButtonBank class:
+
+/**
+ * @class ButtonBank
+ * @brief Requests many buttons of one chip together and reads them as one bitmask.
+ *
+ * Bit `i` of the masks returned by readMask()/getMask() is the LOGICAL state
+ * (polarity applied) of the i-th button passed to add().
+ *
+ * Polarity may differ per button (it is applied in software). libgpiod v1
+ * applies bias per request, so all buttons of a bank must share the same bias.
+ *
+ * @note The bank owns the lines while begun: use readMask()/getMask() instead
+ *       of Button::read() for its buttons. Buttons must outlive the bank.
+ */
+class ButtonBank
+{
+    public:
+
+        /**
+         * @brief Maximum number of buttons per bank (libgpiod bulk limit).
+         */
+        static constexpr size_t MAX_BUTTONS = 64;
+
+        /**
+         * @brief Stores last error message (set if an operation fails).
+         */
+        std::string errorMessage;
+
+        ButtonBank() = default;
+
+        ButtonBank(const ButtonBank&) = delete;
+        ButtonBank& operator=(const ButtonBank&) = delete;
+
+        /**
+         * @brief Destructor. Calls @ref clean().
+         */
+        ~ButtonBank();
+
+        /**
+         * @brief Register a button. Must be on the same chip and bias as the first one.
+         * @param btn Button to register (must outlive the bank).
+         * @return Bit index of the button in the masks, or -1 on error (see errorMessage).
+         */
+        int add(Button& btn);
+
+        /**
+         * @brief Request all registered lines as inputs with one bulk request.
+         * @return true on success, false on failure (see @ref errorMessage).
+         */
+        bool begin(void);
+
+        /**
+         * @brief Release the bulk request (safe to call multiple times).
+         *
+         * Registered buttons are kept; begin() can be called again.
+         */
+        void clean(void);
+
+        /**
+         * @brief Read every LOGICAL state with a single ioctl.
+         * @param ok Optional; set to false if the hardware read failed.
+         * @return Bitmask of pressed buttons (bit i = i-th added button).
+         *         On failure the last cached mask is returned.
+         */
+        uint64_t readMask(bool* ok = nullptr);
+
+        /**
+         * @brief Get the last cached LOGICAL bitmask (no hardware access).
+         */
+        uint64_t getMask(void) const;
+
+        /**
+         * @brief Number of registered buttons.
+         */
+        size_t size(void) const;
+
+    private:
+
+        friend class ButtonGroup;
+
+        std::vector<Button*> _buttons;          ///< Registered buttons, in bit order
+        std::vector<unsigned int> _offsets;     ///< Line offsets, in bit order
+        ButtonChip*     _chip = nullptr;        ///< Shared chip of the bulk request (ButtonChipCache)
+#if BUTTON_BACKEND == BUTTON_BACKEND_GPIOD_V1
+        gpiod_line_bulk* _bulk = nullptr;       ///< Owned bulk of requested lines
+#else
+        int             _fd = -1;               ///< uAPI v2 request fd of all lines (-1 = none)
+#endif
+        uint64_t        _invertMask = 0;        ///< Bits of active-low buttons
+        uint64_t        _mask = 0;              ///< Last LOGICAL bitmask
+
+        /**
+         * @brief True while the bulk request is held.
+         */
+        bool _requested(void) const;
+
+        /**
+         * @brief Request every registered line as an input (chip already acquired).
+         * @return true on success; on failure errorMessage is set and nothing is held but _chip.
+         */
+        bool _requestLines(void);
+
+        /**
+         * @brief Read the RAW levels of all lines (bit i = i-th button).
+         * @return false if the hardware read failed.
+         */
+        bool _readRaw(uint64_t& raw);
+};
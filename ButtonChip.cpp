@@ -0,0 +1,97 @@
+// #######################################################################
+// Include Libraries:
+
+#include "ButtonChip.h"
+#include "ButtonBackend.h"
+#if BUTTON_BACKEND != BUTTON_BACKEND_UAPI
+#include <gpiod.h>
+#endif
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+// #######################################################################
+// ButtonChipCache class:
+
+ButtonChipCache::Registry& ButtonChipCache::_registry(void)
+{
+    static Registry* registry = new Registry;
+    return *registry;
+}
+
+ButtonChip* ButtonChipCache::acquire(const std::string& path)
+{
+    Registry& r = _registry();
+    std::lock_guard<std::mutex> lock(r.lock);
+
+    for (const std::unique_ptr<ButtonChip>& c : r.chips) {
+        if (c->path == path) {
+            ++c->refs;
+            return c.get();
+        }
+    }
+
+    r.chips.emplace_back(new ButtonChip);
+    ButtonChip* c = r.chips.back().get();
+    c->path = path;
+    c->refs = 1;
+    return c;
+}
+
+void ButtonChipCache::release(ButtonChip* chip)
+{
+    if (!chip) return;
+
+    Registry& r = _registry();
+    std::lock_guard<std::mutex> lock(r.lock);
+
+    if (--chip->refs > 0) return;
+
+#if BUTTON_BACKEND != BUTTON_BACKEND_UAPI
+    if (chip->chip) gpiod_chip_close(chip->chip);
+#endif
+    chip->chip = nullptr;
+    if (chip->fd >= 0) ::close(chip->fd);
+    chip->fd = -1;
+    // The entry stays cached: a retry loop re-acquiring the path allocates nothing
+}
+
+gpiod_chip* ButtonChipCache::gpiod(ButtonChip* chip, int& err)
+{
+    Registry& r = _registry();
+    std::lock_guard<std::mutex> lock(r.lock);
+
+#if BUTTON_BACKEND != BUTTON_BACKEND_UAPI
+    if (!chip->chip) {
+        chip->chip = gpiod_chip_open(chip->path.c_str());
+        if (!chip->chip) err = errno;
+    }
+#else
+    err = ENOTSUP;      // built without libgpiod: only fd() handles exist
+#endif
+    return chip->chip;
+}
+
+int ButtonChipCache::fd(ButtonChip* chip, int& err)
+{
+    Registry& r = _registry();
+    std::lock_guard<std::mutex> lock(r.lock);
+
+    if (chip->fd < 0) {
+        chip->fd = ::open(chip->path.c_str(), O_RDWR | O_CLOEXEC);
+        if (chip->fd < 0) err = errno;
+    }
+    return chip->fd;
+}
+
+size_t ButtonChipCache::size(void)
+{
+    Registry& r = _registry();
+    std::lock_guard<std::mutex> lock(r.lock);
+
+    size_t n = 0;
+    for (const std::unique_ptr<ButtonChip>& c : r.chips) {
+        if (c->chip || c->fd >= 0) ++n;
+    }
+    return n;
+}
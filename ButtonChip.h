@@ -0,0 +1,95 @@
+/**
+ * @file ButtonChip.h
+ * @brief Process-wide, reference-counted cache of opened GPIO chips.
+ *
+ * Every line request made by this library (Button event paths, ButtonGroup,
+ * ButtonBank) goes through the cache, so all buttons on /dev/gpiochipN share
+ * one chip handle: the chip is opened (open() + GET_CHIPINFO) once, on the
+ * first request, and closed when the last request on it is released. The
+ * closed entry stays in the cache, so acquiring the same path again (e.g. a
+ * try*() retry loop) never allocates.
+ * Requested lines keep their own fds; only the chip handle is shared.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Include libraries:
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct gpiod_chip;
+
+// #################################################################################
+// ButtonChip class:
+
+/**
+ * @brief One cached chip. Obtained from ButtonChipCache::acquire(), never built directly.
+ */
+struct ButtonChip
+{
+    std::string     path;               ///< Chip device path (cache key)
+    gpiod_chip*     chip = nullptr;     ///< libgpiod handle (opened on first use)
+    int             fd = -1;            ///< Raw chip fd for uAPI v2 ioctls (opened on first use)
+    unsigned int    refs = 0;           ///< Holders (acquire() minus release())
+};
+
+/**
+ * @class ButtonChipCache
+ * @brief Shares one opened chip per path between all holders. Thread-safe.
+ */
+class ButtonChipCache
+{
+    public:
+
+        /**
+         * @brief Take a reference on the chip at @p path (entry created on the first use of the path).
+         * @return Handle (never nullptr); pass it to release() exactly once.
+         */
+        static ButtonChip* acquire(const std::string& path);
+
+        /**
+         * @brief Drop a reference; the chip is closed with the last one, its entry kept (nullptr is ignored).
+         */
+        static void release(ButtonChip* chip);
+
+        /**
+         * @brief libgpiod handle of @p chip, opened on first call.
+         * @return Handle, or nullptr with @p err = errno if the chip cannot be opened
+         *         (always nullptr with ENOTSUP in BUTTON_BACKEND_UAPI builds).
+         */
+        static gpiod_chip* gpiod(ButtonChip* chip, int& err);
+
+        /**
+         * @brief Raw chip fd of @p chip for GPIO uAPI v2 ioctls, opened on first call.
+         * @return File descriptor, or -1 with @p err = errno if the chip cannot be opened.
+         */
+        static int fd(ButtonChip* chip, int& err);
+
+        /**
+         * @brief Number of chips currently held open by the cache.
+         */
+        static size_t size(void);
+
+    private:
+
+        /**
+         * @brief Cache state shared by the whole process.
+         */
+        struct Registry
+        {
+            std::mutex  lock;                               ///< Guards chips and every ButtonChip
+            std::vector<std::unique_ptr<ButtonChip>> chips; ///< Every path used so far (stable addresses)
+        };
+
+        /**
+         * @brief The registry (never destroyed, so static Buttons may release late).
+         */
+        static Registry& _registry(void);
+};
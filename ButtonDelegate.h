@@ -0,0 +1,207 @@
+/**
+ * @file ButtonDelegate.h
+ * @brief Non-allocating callable wrapper for Button edge callbacks.
+ *
+ * ButtonDelegate stores a plain GpioCallback or GpioNsCallback, a `void* user`
+ * context callback, a bound member function or any small trivially copyable
+ * functor (e.g. a lambda capturing `this`) inside a fixed in-object buffer.
+ * Construction never allocates and invoking it is a single indirect call
+ * through a thunk. Timestamps travel as one 64-bit nanosecond value; they are
+ * only split into `sec`/`nsec` for targets with the legacy signature.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Include libraries:
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// #################################################################################
+
+/**
+ * @brief GPIO edge event callback signature used by Button::beginInterrupt().
+ *
+ * @param is_rising True for rising edge; false for falling edge.
+ * @param sec       Kernel timestamp seconds component.
+ * @param nsec      Kernel timestamp nanoseconds component.
+ */
+using GpioCallback = void(*)(bool is_rising, long sec, long nsec);
+
+/**
+ * @brief Edge callback with an opaque user context pointer.
+ *
+ * @param user      Context pointer given at registration.
+ * @param is_rising True for rising edge; false for falling edge.
+ * @param sec       Kernel timestamp seconds component.
+ * @param nsec      Kernel timestamp nanoseconds component.
+ */
+using GpioUserCallback = void(*)(void* user, bool is_rising, long sec, long nsec);
+
+/**
+ * @brief Edge callback with a single 64-bit timestamp.
+ *
+ * @param is_rising True for rising edge; false for falling edge.
+ * @param ts_ns     Edge timestamp in nanoseconds of the event clock (Button::setEventClock()).
+ */
+using GpioNsCallback = void(*)(bool is_rising, uint64_t ts_ns);
+
+// #################################################################################
+// ButtonDelegate class:
+
+/**
+ * @class ButtonDelegate
+ * @brief Small-buffer, non-allocating `void(bool, uint64_t)` callable.
+ *
+ * Accepted targets:
+ *  - GpioNsCallback and GpioCallback function pointers (implicit conversion, source compatible)
+ *  - GpioUserCallback + `void* user` context
+ *  - Member functions `void(bool, uint64_t)` or `void(bool, long, long)`:
+ *    `ButtonDelegate::bind<&Controller::onEdge>(this)`
+ *  - Functors/lambdas up to @ref STORAGE_SIZE bytes that are trivially copyable
+ *    (checked at compile time; capture pointers or references, not containers),
+ *    taking `(bool, uint64_t)` or `(bool, long, long)`
+ */
+class ButtonDelegate
+{
+    public:
+
+        /**
+         * @brief Bytes of in-object storage available for a functor.
+         */
+        static constexpr size_t STORAGE_SIZE = 3 * sizeof(void*);
+
+        /**
+         * @brief Empty delegate (evaluates to false).
+         */
+        ButtonDelegate() noexcept = default;
+
+        /**
+         * @brief Empty delegate from nullptr.
+         */
+        ButtonDelegate(std::nullptr_t) noexcept {}
+
+        /**
+         * @brief Wrap a plain C-style callback (null gives an empty delegate).
+         */
+        ButtonDelegate(GpioCallback fn) noexcept
+        {
+            if (fn) _store(fn, [](const void* s, bool r, uint64_t ts) {
+                (*static_cast<const GpioCallback*>(s))(r, _sec(ts), _nsec(ts));
+            });
+        }
+
+        /**
+         * @brief Wrap a plain 64-bit timestamp callback (null gives an empty delegate).
+         */
+        ButtonDelegate(GpioNsCallback fn) noexcept
+        {
+            if (fn) _store(fn, [](const void* s, bool r, uint64_t ts) {
+                (*static_cast<const GpioNsCallback*>(s))(r, ts);
+            });
+        }
+
+        /**
+         * @brief Wrap a callback with a user context pointer (null @p fn gives an empty delegate).
+         */
+        ButtonDelegate(GpioUserCallback fn, void* user) noexcept
+        {
+            if (fn) _store(UserTarget{fn, user}, [](const void* s, bool r, uint64_t ts) {
+                const UserTarget* t = static_cast<const UserTarget*>(s);
+                t->fn(t->user, r, _sec(ts), _nsec(ts));
+            });
+        }
+
+        /**
+         * @brief Wrap a small trivially copyable functor (e.g. a lambda capturing `this`).
+         */
+        template <typename F,
+                  typename D = std::decay_t<F>,
+                  typename = std::enable_if_t<!std::is_same<D, ButtonDelegate>::value &&
+                                              !std::is_pointer<D>::value &&
+                                              !std::is_function<std::remove_reference_t<F>>::value>>
+        ButtonDelegate(F&& f) noexcept
+        {
+            static_assert(sizeof(D) <= STORAGE_SIZE, "ButtonDelegate: functor too large for the inline buffer.");
+            static_assert(alignof(D) <= alignof(void*), "ButtonDelegate: functor alignment not supported.");
+            static_assert(std::is_trivially_copyable<D>::value && std::is_trivially_destructible<D>::value,
+                          "ButtonDelegate: functor must be trivially copyable (capture pointers/references only).");
+            _store(D(std::forward<F>(f)), [](const void* s, bool r, uint64_t ts) {
+                D& fn = *static_cast<D*>(const_cast<void*>(s));
+                if constexpr (std::is_invocable<D&, bool, uint64_t>::value) fn(r, ts);
+                else                                                         fn(r, _sec(ts), _nsec(ts));
+            });
+        }
+
+        /**
+         * @brief Bind a member function `void T::M(bool, uint64_t)` or `void T::M(bool, long, long)` to an object.
+         *
+         * Example: `ButtonDelegate::bind<&Panel::onStart>(this)`.
+         */
+        template <auto M, typename T>
+        static ButtonDelegate bind(T* obj) noexcept
+        {
+            ButtonDelegate d;
+            d._store(obj, [](const void* s, bool r, uint64_t ts) {
+                T* o = *static_cast<T* const*>(s);
+                if constexpr (std::is_invocable<decltype(M), T*, bool, uint64_t>::value) (o->*M)(r, ts);
+                else                                                                     (o->*M)(r, _sec(ts), _nsec(ts));
+            });
+            return d;
+        }
+
+        /**
+         * @brief True if a target is stored.
+         */
+        explicit operator bool() const noexcept
+        {
+            return _thunk != nullptr;
+        }
+
+        /**
+         * @brief Invoke the target (must not be empty).
+         */
+        void operator()(bool is_rising, uint64_t ts_ns) const
+        {
+            _thunk(_storage, is_rising, ts_ns);
+        }
+
+        /**
+         * @brief Invoke the target with a split timestamp (must not be empty).
+         */
+        void operator()(bool is_rising, long sec, long nsec) const
+        {
+            _thunk(_storage, is_rising, static_cast<uint64_t>(sec) * 1000000000ULL + static_cast<uint64_t>(nsec));
+        }
+
+    private:
+
+        using Thunk = void(*)(const void* storage, bool is_rising, uint64_t ts_ns);
+
+        static long _sec(uint64_t ts_ns) noexcept  { return static_cast<long>(ts_ns / 1000000000ULL); }
+        static long _nsec(uint64_t ts_ns) noexcept { return static_cast<long>(ts_ns % 1000000000ULL); }
+
+        struct UserTarget
+        {
+            GpioUserCallback fn;
+            void*            user;
+        };
+
+        Thunk _thunk = nullptr;                                 ///< Type-erased invoker
+        alignas(void*) unsigned char _storage[STORAGE_SIZE] {}; ///< Inline target storage
+
+        template <typename T>
+        void _store(const T& target, Thunk thunk) noexcept
+        {
+            static_assert(sizeof(T) <= STORAGE_SIZE, "ButtonDelegate: target too large.");
+            std::memcpy(_storage, &target, sizeof(T));
+            _thunk = thunk;
+        }
+};
@@ -0,0 +1,32 @@
+// #######################################################################
+// Include Libraries:
+
+#include "ButtonError.h"
+#include <string>
+
+// #######################################################################
+// ButtonError category:
+
+namespace
+{
+    class ButtonErrorCategory : public std::error_category
+    {
+        public:
+
+            const char* name(void) const noexcept override
+            {
+                return "button";
+            }
+
+            std::string message(int ev) const override
+            {
+                return buttonErrorMessage(static_cast<ButtonError>(ev));
+            }
+    };
+}
+
+const std::error_category& buttonErrorCategory(void) noexcept
+{
+    static const ButtonErrorCategory category;
+    return category;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file ButtonError.h
+ * @brief Allocation-free error codes of the Button library.
+ *
+ * Every failure is recorded as a ButtonError plus the errno of the failing
+ * call. Messages come from a static table, so checking, retrying and logging
+ * a failure code never touches the heap. ButtonError also converts to
+ * std::error_code (category "button").
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Include libraries:
+
+#include <cstdint>
+#include <system_error>
+
+// #################################################################################
+// ButtonError:
+
+/**
+ * @brief Failure reason of a Button / ButtonGroup operation.
+ */
+enum class ButtonError : uint8_t
+{
+    None = 0,           ///< Success
+    InvalidEdge,        ///< Edge selector is not 0, 1 or 2
+    NullCallback,       ///< Callback is empty (and neither an event queue nor coalescing is enabled)
+    AuxiBegin,          ///< AUXI::begin() failed (details in AUXI's errorMessage)
+    ChipOpen,           ///< gpiochip device could not be opened
+    LineGet,            ///< Line offset does not exist on the chip
+    LineRequest,        ///< Edge event line request was refused
+    KernelDebounce,     ///< uAPI v2 request with debounce period was refused
+    NonBlock,           ///< fcntl(O_NONBLOCK) on the event fd failed
+    EventFd,            ///< eventfd() failed
+    MemoryLock,         ///< mlockall() failed
+    ThreadName,         ///< pthread_setname_np() failed
+    ThreadAffinity,     ///< pthread_setaffinity_np() failed
+    ThreadScheduling,   ///< pthread_setschedparam() failed
+    EventClock,         ///< uAPI v2 request with the selected event clock was refused
+    LineGone,           ///< Event fd hung up or failed while served (chip unplugged); polling stopped
+    Count               ///< Number of codes (not an error)
+};
+
+/**
+ * @brief Static description of @p e (never allocates; never nullptr).
+ */
+constexpr const char* buttonErrorMessage(ButtonError e) noexcept
+{
+    constexpr const char* table[] = {
+        "no error",
+        "edge selection is not correct (must be 0,1,2)",
+        "callback is null",
+        "AUXI begin() failed",
+        "failed to open gpiochip",
+        "failed to get line",
+        "event request failed",
+        "kernel debounce request failed",
+        "fcntl(O_NONBLOCK) failed",
+        "eventfd failed",
+        "mlockall failed",
+        "pthread_setname_np failed",
+        "pthread_setaffinity_np failed",
+        "pthread_setschedparam failed",
+        "event clock not supported",
+        "event line hung up or failed",
+    };
+    static_assert(sizeof(table) / sizeof(table[0]) == static_cast<size_t>(ButtonError::Count),
+                  "buttonErrorMessage: table and ButtonError are out of sync");
+
+    const size_t i = static_cast<size_t>(e);
+    return i < static_cast<size_t>(ButtonError::Count) ? table[i] : "unknown error";
+}
+
+/**
+ * @brief std::error_category of ButtonError ("button").
+ */
+const std::error_category& buttonErrorCategory(void) noexcept;
+
+/**
+ * @brief Wrap @p e in a std::error_code.
+ */
+inline std::error_code make_error_code(ButtonError e) noexcept
+{
+    return std::error_code(static_cast<int>(e), buttonErrorCategory());
+}
+
+namespace std
+{
+    template <>
+    struct is_error_code_enum<ButtonError> : true_type {};
+}
@@ -0,0 +1,1020 @@
+// #######################################################################
+// Include Libraries:
+
+#include "ButtonGroup.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// #######################################################################
+// ButtonGroup class:
+
+ButtonGroup::~ButtonGroup()
+{
+    clean();
+}
+
+bool ButtonGroup::add(Button& btn, uint8_t edge, uint32_t debounce_us, ButtonDelegate cb)
+{
+    AUXI::Edge sel;
+    switch (edge) {
+        case 0:  sel = AUXI::Edge::Both;    break;
+        case 1:  sel = AUXI::Edge::Rising;  break;
+        case 2:  sel = AUXI::Edge::Falling; break;
+        default:
+            errorMessage = "edge selection is not correct (must be 0,1,2).";
+            return false;
+    }
+    return add(btn, sel, debounce_us, cb);
+}
+
+bool ButtonGroup::add(Button& btn, AUXI::Edge edge, uint32_t debounce_us, GpioUserCallback cb, void* user)
+{
+    if (!cb) {
+        errorMessage = "ButtonGroup: callback is null.";
+        return false;
+    }
+    return add(btn, edge, debounce_us, ButtonDelegate(cb, user));
+}
+
+bool ButtonGroup::add(Button& btn, AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb)
+{
+    if (!cb && !btn._queue && !btn._coalesce) {
+        errorMessage = "ButtonGroup: callback is null.";
+        return false;
+    }
+    for (const Entry& e : _entries) {
+        if (e.btn == &btn) {
+            errorMessage = "ButtonGroup: button is already registered.";
+            return false;
+        }
+    }
+
+    _entries.push_back(Entry{&btn, edge, debounce_us, cb, false, false, -1});
+
+    if (_running.load()) {
+        if (!_attach(_entries.back())) {
+            _entries.pop_back();
+            return false;
+        }
+        btn._evWaitList.store(&_waits, std::memory_order_release);
+    }
+    btn._group = this;
+    return true;
+}
+
+bool ButtonGroup::addPolled(Button& btn, uint8_t edge, uint32_t debounce_us, ButtonDelegate cb)
+{
+    AUXI::Edge sel;
+    switch (edge) {
+        case 0:  sel = AUXI::Edge::Both;    break;
+        case 1:  sel = AUXI::Edge::Rising;  break;
+        case 2:  sel = AUXI::Edge::Falling; break;
+        default:
+            errorMessage = "edge selection is not correct (must be 0,1,2).";
+            return false;
+    }
+    return addPolled(btn, sel, debounce_us, cb);
+}
+
+bool ButtonGroup::addPolled(Button& btn, AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb)
+{
+    if (_running.load() || !_banks.empty()) {
+        errorMessage = "ButtonGroup: polled buttons must be added before begin().";
+        return false;
+    }
+    if (!cb && !btn._queue && !btn._coalesce) {
+        errorMessage = "ButtonGroup: callback is null.";
+        return false;
+    }
+    for (const Entry& e : _entries) {
+        if (e.btn == &btn) {
+            errorMessage = "ButtonGroup: button is already registered.";
+            return false;
+        }
+    }
+
+    _entries.push_back(Entry{&btn, edge, debounce_us, cb, false, true, -1});
+    btn._group = this;
+    return true;
+}
+
+bool ButtonGroup::add(Button& btn, AUXI::Edge edge, const DebounceConfig& cfg, ButtonDelegate cb)
+{
+    if (_running.load()) {
+        errorMessage = "ButtonGroup: debounced buttons must be added before begin().";
+        return false;
+    }
+    // The engine needs both edges to follow the raw level; no per-button window
+    if (!add(btn, AUXI::Edge::Both, 0, cb)) return false;
+
+    _debouncer.setCallback(&ButtonGroup::_onDebounced, this);
+    _entries.back().debounceId = static_cast<int32_t>(_debouncer.add(cfg, false));
+    _debounced.push_back(&btn);
+    _debouncedEdge.push_back(edge);
+    return true;
+}
+
+bool ButtonGroup::addPolled(Button& btn, AUXI::Edge edge, const DebounceConfig& cfg, ButtonDelegate cb)
+{
+    if (!addPolled(btn, AUXI::Edge::Both, 0, cb)) return false;
+
+    _debouncer.setCallback(&ButtonGroup::_onDebounced, this);
+    _entries.back().debounceId = static_cast<int32_t>(_debouncer.add(cfg, false));
+    _debounced.push_back(&btn);
+    _debouncedEdge.push_back(edge);
+    return true;
+}
+
+int ButtonGroup::addChord(std::initializer_list<Button*> buttons, uint32_t hold_ms, ChordCallback cb,
+                          void* user, bool exclusive)
+{
+    if (_running.load()) {
+        errorMessage = "ButtonGroup: chords must be added before begin().";
+        return -1;
+    }
+    if (!cb) {
+        errorMessage = "ButtonGroup: chord callback is null.";
+        return -1;
+    }
+    if (buttons.size() < 2) {
+        errorMessage = "ButtonGroup: a chord needs at least 2 buttons.";
+        return -1;
+    }
+
+    // Validate everything first so a failed call hands out no bits
+    unsigned int fresh = 0;
+    for (Button* btn : buttons) {
+        const Entry* entry = nullptr;
+        for (const Entry& e : _entries) {
+            if (e.btn == btn) { entry = &e; break; }
+        }
+        if (!btn || !entry) {
+            errorMessage = "ButtonGroup: chord button is not registered in this group.";
+            return -1;
+        }
+        const AUXI::Edge edge = entry->debounceId >= 0 ? _debouncedEdge[static_cast<size_t>(entry->debounceId)] : entry->edge;
+        if (edge != AUXI::Edge::Both) {
+            errorMessage = "ButtonGroup: chord button on line " + std::to_string(btn->_pin) +
+                           " must be registered with AUXI::Edge::Both.";
+            return -1;
+        }
+        if (btn->_chordBit < 0) ++fresh;
+    }
+    if (_chordBits + fresh > MAX_CHORD_BUTTONS) {
+        errorMessage = "ButtonGroup: more than " + std::to_string(MAX_CHORD_BUTTONS) + " chord buttons.";
+        return -1;
+    }
+
+    uint64_t mask = 0;
+    for (Button* btn : buttons) {
+        if (btn->_chordBit < 0) {
+            btn->_chordBit = static_cast<int>(_chordBits++);
+            _chordMembers[btn->_chordBit] = btn;
+        }
+        mask |= 1ULL << btn->_chordBit;
+    }
+
+    const unsigned int id = static_cast<unsigned int>(_chords.size());
+    _chords.push_back(Chord{this, id, mask, static_cast<int64_t>(hold_ms) * 1000000LL, cb, user, exclusive, false, {}});
+    Chord& c = _chords.back();
+    c.timer.fn = &ButtonGroup::_onChordTimer;
+    c.timer.ctx = &c;
+
+    // Rebuild the per-bit index: members, plus every exclusive chord for any bit
+    for (unsigned int b = 0; b < _chordBits; ++b) {
+        _chordsOf[b].clear();
+        for (Chord& k : _chords) {
+            if (k.exclusive || ((k.mask >> b) & 1ULL)) _chordsOf[b].push_back(&k);
+        }
+    }
+    return static_cast<int>(id);
+}
+
+void ButtonGroup::setPollInterval(uint32_t min_us, uint32_t max_us)
+{
+    _pollMin_us = min_us ? min_us : 1;
+    _pollMax_us = max_us < _pollMin_us ? _pollMin_us : max_us;
+    _poll_us = _pollMin_us;
+}
+
+void ButtonGroup::setBackend(Backend backend)
+{
+    if (_running.load()) return;
+    _backend = backend;
+}
+
+bool ButtonGroup::usingIoUring(void) const
+{
+    return _running.load() && _useUring;
+}
+
+bool ButtonGroup::begin(void)
+{
+    if (_running.load()) return true;
+
+    if (!_prepare()) return false;
+
+    for (Entry& e : _entries) {
+        if (!e.polled && !e.requested && !_attach(e)) return false;
+    }
+    if (!_beginPolling()) return false;
+
+    return _start();
+}
+
+bool ButtonGroup::beginAll(unsigned int maxThreads)
+{
+    if (_running.load()) return true;
+
+    if (!_prepare()) return false;
+
+    // Lines still to request, one list per chip (the chip handle is shared through the cache)
+    std::vector<std::vector<size_t>> chips;
+    std::vector<const std::string*> paths;
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        const Entry& e = _entries[i];
+        if (e.polled || e.requested) continue;
+
+        size_t c = 0;
+        while (c < paths.size() && *paths[c] != e.btn->_chipPath) ++c;
+        if (c == paths.size()) {
+            paths.push_back(&e.btn->_chipPath);
+            chips.emplace_back();
+        }
+        chips[c].push_back(i);
+    }
+
+    // Each worker owns whole chips, so no two threads touch the same chip handle
+    std::vector<uint8_t> ok(_entries.size(), 0);
+    std::atomic<size_t> next{0};
+    auto work = [this, &chips, &ok, &next]() {
+        for (size_t c = next.fetch_add(1); c < chips.size(); c = next.fetch_add(1)) {
+            for (size_t i : chips[c]) {
+                Entry& e = _entries[i];
+                ok[i] = e.btn->_requestEvents(e.edge, e.debounce_us, e.cb) ? 1 : 0;
+            }
+        }
+    };
+
+    size_t workers = chips.size();
+    if (maxThreads && workers > maxThreads) workers = maxThreads;
+    if (workers <= 1) {
+        work();
+    } else {
+        std::vector<std::thread> pool;
+        pool.reserve(workers - 1);
+        for (size_t t = 1; t < workers; ++t) pool.emplace_back(work);
+        work();
+        for (std::thread& t : pool) t.join();
+    }
+
+    // Registration is cheap and touches group state: done here, in entry order
+    std::string failed;
+    size_t nfailed = 0;
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        Entry& e = _entries[i];
+        if (e.polled || e.requested) continue;
+
+        if (ok[i] && _register(e)) continue;
+        if (ok[i]) e.btn->errorMessage = errorMessage;      // requested, but not registered in the loop
+        else       e.btn->_formatError();
+        if (nfailed++) failed += "; ";
+        failed += e.btn->_chipPath + ":" + std::to_string(e.btn->_pin) + ": " + e.btn->errorMessage;
+    }
+
+    if (!_beginPolling()) return false;
+    if (!_start()) return false;
+
+    if (nfailed) {
+        errorMessage = "ButtonGroup: " + std::to_string(nfailed) + " of " + std::to_string(_entries.size()) +
+                       " buttons failed: " + failed;
+        return false;
+    }
+    return true;
+}
+
+bool ButtonGroup::_prepare(void)
+{
+    if (!_open()) return false;
+
+    _useUring = false;
+    if (_backend != Backend::Epoll) {
+        // Room for one posted read per line plus the wake fd; NODROP covers later adds
+        unsigned int depth = 64;
+        while (depth < _entries.size() + 16) depth <<= 1;
+        if (_uring.open(depth)) {
+            _useUring = true;
+        } else if (_backend == Backend::IoUring) {
+            errorMessage = "ButtonGroup: " + _uring.errorMessage;
+            return false;
+        }
+    }
+
+    // The epoll loop drains the wake fd non-blocking; io_uring reads it like a line fd
+    const int wfl = ::fcntl(_wakefd, F_GETFL);
+    if (wfl >= 0) ::fcntl(_wakefd, F_SETFL, _useUring ? (wfl & ~O_NONBLOCK) : (wfl | O_NONBLOCK));
+    return true;
+}
+
+bool ButtonGroup::_start(void)
+{
+    if (_useUring) {
+        std::lock_guard<std::mutex> lock(_uringLock);
+        _uringPending.clear();
+        for (Entry& e : _entries) {
+            if (e.requested && !e.polled) _uringPending.push_back(e.btn);
+        }
+    }
+
+    if (_threadOpts.lockMemory && ::mlockall(MCL_CURRENT | MCL_FUTURE) < 0) {
+        errorMessage = std::string("ButtonGroup: mlockall failed: ") + std::strerror(errno);
+        return false;
+    }
+
+    _waits.open(_wakefd);
+    for (Entry& e : _entries) e.btn->_evWaitList.store(&_waits, std::memory_order_release);
+    _seedChords();
+    return _resume();
+}
+
+bool ButtonGroup::_resume(void)
+{
+    _running.store(true);
+    _thread = std::thread(_useUring ? &ButtonGroup::_loopUring : &ButtonGroup::_loop, this);
+
+    int err = 0;
+    const ButtonError e = Button::_applyThreadOptions(_thread, _threadOpts, err);
+    if (e != ButtonError::None) {
+        stop();
+        errorMessage = std::string("ButtonGroup: ") + buttonErrorMessage(e) + ": " + std::strerror(err);
+        return false;
+    }
+    return true;
+}
+
+void ButtonGroup::setThreadOptions(const ButtonThreadOptions& opts)
+{
+    _threadOpts = opts;
+}
+
+bool ButtonGroup::_pause(void)
+{
+    if (!_running.exchange(false)) return false;
+
+    uint64_t one = 1;
+    if (::write(_wakefd, &one, sizeof(one)) < 0) {
+        // Nothing else to do: the loop also re-checks the flag on every event
+    }
+    if (_thread.joinable()) _thread.join();
+    return true;
+}
+
+void ButtonGroup::stop(void)
+{
+    if (!_pause()) return;
+
+    for (Entry& e : _entries) {
+        ButtonWaitList* ours = &_waits;
+        e.btn->_evWaitList.compare_exchange_strong(ours, nullptr);
+    }
+    _waits.close();     // pending awaits complete as timed out
+
+    _uringShutdown();
+}
+
+void ButtonGroup::clean(void)
+{
+    stop();
+
+    for (Entry& e : _entries) {
+        if (e.polled) { e.btn->_evPolled = false; e.btn->_evDebouncer = nullptr; }
+        else if (e.requested) e.btn->_releaseEvents();
+        if (e.btn->_coalesce) _coalesceWheel.cancel(e.btn->_coalesce->timer);     // the window stays open
+        e.btn->_group = nullptr;
+        e.btn->_chordBit = -1;
+    }
+    _entries.clear();
+    for (Chord& c : _chords) _chordWheel.cancel(c.timer);
+    _chords.clear();
+    for (std::vector<Chord*>& v : _chordsOf) v.clear();
+    for (Button*& b : _chordMembers) b = nullptr;
+    _chordBits = 0;
+    _pressed.store(0, std::memory_order_relaxed);
+    _debounced.clear();
+    _debouncedEdge.clear();
+    _debouncer.clear();
+    _banks.clear();     // ButtonBank destructors release the bulk requests
+
+    if (_wakefd >= 0) { ::close(_wakefd); _wakefd = -1; }
+    if (_epfd >= 0)   { ::close(_epfd);   _epfd = -1; }
+}
+
+bool ButtonGroup::remove(Button& btn)
+{
+    size_t i = 0;
+    while (i < _entries.size() && _entries[i].btn != &btn) ++i;
+    if (i == _entries.size()) return false;
+
+    // Same quiesce as a Button move: the loop is joined, nothing else is torn down
+    const bool wasRunning = _pause();
+
+    Entry& e = _entries[i];
+    const bool polled = e.polled;
+    if (e.debounceId >= 0) _debounced[static_cast<size_t>(e.debounceId)] = nullptr;    // id stays reserved
+    if (e.polled) {
+        btn._evPolled = false;
+        btn._evDebouncer = nullptr;
+        _banks.clear();     // rebuilt without this line below, or by the next begin()
+    }
+    else if (e.requested) {
+        if (_epfd >= 0) ::epoll_ctl(_epfd, EPOLL_CTL_DEL, btn._eventFd(), nullptr);
+        if (_useUring) _uringForget(btn);
+        btn._releaseEvents();
+        btn._evDebouncer = nullptr;
+    }
+
+    ButtonWaitList* ours = &_waits;
+    btn._evWaitList.compare_exchange_strong(ours, nullptr);
+    _waits.drop(&btn);      // only this button's awaits time out
+
+    if (btn._chordBit >= 0) {
+        // The bit stays reserved: chords containing this button can no longer complete
+        const uint64_t bit = 1ULL << btn._chordBit;
+        _pressed.store(_pressed.load(std::memory_order_relaxed) & ~bit, std::memory_order_relaxed);
+        for (Chord* c : _chordsOf[static_cast<size_t>(btn._chordBit)]) {
+            if (c->active && (c->mask & bit)) {
+                _chordWheel.cancel(c->timer);
+                c->active = false;
+            }
+        }
+        _chordMembers[btn._chordBit] = nullptr;
+        btn._chordBit = -1;
+    }
+    if (btn._coalesce) _coalesceWheel.cancel(btn._coalesce->timer);     // the window stays open
+    btn._group = nullptr;
+    _entries.erase(_entries.begin() + static_cast<std::ptrdiff_t>(i));
+
+    if (wasRunning) {
+        // The remaining polled lines keep being served (errorMessage tells if not)
+        if (polled) _beginPolling();
+        _resume();
+    }
+    return true;
+}
+
+void ButtonGroup::setTimerWheel(TimerWheel* wheel)
+{
+    if (_running.load()) return;
+    _wheel = wheel;
+}
+
+size_t ButtonGroup::size(void) const
+{
+    return _entries.size();
+}
+
+uint64_t ButtonGroup::pressedMask(void) const
+{
+    return _pressed.load(std::memory_order_relaxed);
+}
+
+uint64_t ButtonGroup::chordBit(const Button& btn) const
+{
+    return (btn._group == this && btn._chordBit >= 0) ? (1ULL << btn._chordBit) : 0;
+}
+
+void ButtonGroup::writePrometheus(std::string& out, const char* prefix) const
+{
+    struct Metric
+    {
+        const char* name;
+        const char* help;
+        uint64_t ButtonStatsSnapshot::*field;
+    };
+    static const Metric metrics[] = {
+        {"edges_total",           "Raw edges seen by the event path.",              &ButtonStatsSnapshot::edges},
+        {"bounces_total",         "Edges rejected by software debounce.",           &ButtonStatsSnapshot::bounces},
+        {"callbacks_total",       "Accepted edges dispatched.",                     &ButtonStatsSnapshot::callbacks},
+        {"queue_overflows_total", "Events dropped because the queue was full.",     &ButtonStatsSnapshot::overflows},
+        {"wakeups_total",         "Event loop wakeups serving the button.",         &ButtonStatsSnapshot::wakeups},
+        {"syscalls_total",        "Syscalls issued for the button.",                &ButtonStatsSnapshot::syscalls},
+    };
+
+    if (!prefix) prefix = "button";
+
+    std::vector<ButtonStatsSnapshot> snaps;
+    snaps.reserve(_entries.size());
+    for (const Entry& e : _entries) snaps.push_back(e.btn->stats());
+
+    for (const Metric& m : metrics) {
+        out += "# HELP "; out += prefix; out += '_'; out += m.name; out += ' '; out += m.help; out += '\n';
+        out += "# TYPE "; out += prefix; out += '_'; out += m.name; out += " counter\n";
+        for (size_t i = 0; i < _entries.size(); ++i) {
+            const Button* btn = _entries[i].btn;
+            out += prefix; out += '_'; out += m.name;
+            out += "{chip=\""; out += btn->_chipPath;
+            out += "\",line=\""; out += std::to_string(btn->_pin);
+            out += "\"} "; out += std::to_string(snaps[i].*m.field); out += '\n';
+        }
+    }
+}
+
+uint64_t ButtonGroup::timerWakeups(void) const
+{
+    return _timerWakeups.load(std::memory_order_relaxed);
+}
+
+bool ButtonGroup::running(void) const
+{
+    return _running.load();
+}
+
+bool ButtonGroup::_open(void)
+{
+    if (_epfd < 0) {
+        _epfd = ::epoll_create1(EPOLL_CLOEXEC);
+        if (_epfd < 0) {
+            errorMessage = std::string("ButtonGroup: epoll_create1 failed: ") + std::strerror(errno);
+            return false;
+        }
+    }
+
+    if (_wakefd < 0) {
+        _wakefd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (_wakefd < 0) {
+            errorMessage = std::string("ButtonGroup: eventfd failed: ") + std::strerror(errno);
+            return false;
+        }
+
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = nullptr;      // nullptr marks the wake fd
+        if (::epoll_ctl(_epfd, EPOLL_CTL_ADD, _wakefd, &ev) < 0) {
+            errorMessage = std::string("ButtonGroup: epoll_ctl failed: ") + std::strerror(errno);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ButtonGroup::_attach(Entry& e)
+{
+    if (!e.btn->_requestEvents(e.edge, e.debounce_us, e.cb)) {
+        e.btn->_formatError();
+        errorMessage = "ButtonGroup: " + e.btn->errorMessage;
+        return false;
+    }
+    return _register(e);
+}
+
+bool ButtonGroup::_register(Entry& e)
+{
+    if (_useUring) {
+        // begin() queues every requested entry; while running the loop posts the read
+        if (_running.load()) {
+            {
+                std::lock_guard<std::mutex> lock(_uringLock);
+                _uringPending.push_back(e.btn);
+            }
+            uint64_t one = 1;
+            if (::write(_wakefd, &one, sizeof(one)) < 0) {
+                // Counter saturated: the loop is already due to wake up
+            }
+        }
+        e.requested = true;
+        _bindDebouncer(e);
+        return true;
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.ptr = e.btn;
+    if (::epoll_ctl(_epfd, EPOLL_CTL_ADD, e.btn->_eventFd(), &ev) < 0) {
+        errorMessage = std::string("ButtonGroup: epoll_ctl failed: ") + std::strerror(errno);
+        e.btn->_releaseEvents();
+        return false;
+    }
+
+    e.requested = true;
+    _bindDebouncer(e);
+    return true;
+}
+
+void ButtonGroup::_relocate(Button* from, Button* to)
+{
+    for (Entry& e : _entries) {
+        if (e.btn != from) continue;
+        e.btn = to;
+
+        // Same fd (it moved with the Button), new epoll cookie
+        if (e.requested && !e.polled && _epfd >= 0) {
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.ptr = to;
+            ::epoll_ctl(_epfd, EPOLL_CTL_MOD, to->_eventFd(), &ev);
+        }
+    }
+    for (Button*& b : _debounced) {
+        if (b == from) b = to;
+    }
+    for (PollBank& pb : _banks) {
+        for (Button*& b : pb.btns) {
+            if (b == from) b = to;
+        }
+        for (Button*& b : pb.bank->_buttons) {
+            if (b == from) b = to;
+        }
+    }
+
+    // A paused io_uring loop keeps its reads posted: only the owner changes
+    for (UringRead& r : _uringReads) {
+        if (r.btn == from) r.btn = to;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_uringLock);
+        for (Button*& b : _uringPending) {
+            if (b == from) b = to;
+        }
+    }
+    for (Button*& b : _chordMembers) {
+        if (b == from) b = to;
+    }
+    _waits.retarget(from, to);
+    to->_group = this;
+}
+
+void ButtonGroup::_bindDebouncer(Entry& e)
+{
+    if (e.debounceId < 0) return;
+
+    const uint32_t id = static_cast<uint32_t>(e.debounceId);
+    _debouncer.reset(id, e.btn->get());
+    e.btn->_evDebounceId = id;
+    e.btn->_evDebouncer = &_debouncer;
+}
+
+void ButtonGroup::_onDebounced(void* ctx, uint32_t id, bool state, int64_t ts_ns)
+{
+    ButtonGroup* self = static_cast<ButtonGroup*>(ctx);
+    Button* btn = self->_debounced[id];
+    if (!btn) return;       // removed from the group
+    btn->_stats.add(ButtonStats::Accepted);
+
+    const AUXI::Edge edge = self->_debouncedEdge[id];
+    if ((edge == AUXI::Edge::Rising && !state) || (edge == AUXI::Edge::Falling && state)) return;
+
+    ButtonEvent ev = ButtonEvent::make(state, btn->_pin, static_cast<uint64_t>(ts_ns));
+    btn->_dispatch(ev);
+}
+
+void ButtonGroup::_chordEdge(unsigned int bit, bool pressed, int64_t ts_ns)
+{
+    // Single writer (the loop thread): a relaxed load/store publishes the mask
+    uint64_t m = _pressed.load(std::memory_order_relaxed);
+    m = pressed ? (m | (1ULL << bit)) : (m & ~(1ULL << bit));
+    _pressed.store(m, std::memory_order_relaxed);
+
+    const uint64_t all = (_chordBits >= 64) ? ~0ULL : ((1ULL << _chordBits) - 1);
+    for (Chord* c : _chordsOf[bit]) {
+        // Reload: a confirm below may have cleared stale bits
+        m = _pressed.load(std::memory_order_relaxed);
+        const bool held = c->exclusive ? (m & all) == c->mask : (m & c->mask) == c->mask;
+        if (held == c->active) continue;
+
+        c->active = held;
+        // The press edge itself is authoritative: contacts may still bounce right now
+        if (!held)               _chordWheel.cancel(c->timer);
+        else if (c->hold_ns > 0) _chordWheel.schedule(c->timer, ts_ns + c->hold_ns);
+        else                     c->cb(c->user, c->id);
+    }
+}
+
+void ButtonGroup::_onChordTimer(void* ctx)
+{
+    Chord* c = static_cast<Chord*>(ctx);
+    if (!c->group->_chordConfirm(*c, c->timer.deadline_ns)) return;
+    c->cb(c->user, c->id);      // stays active: fires again only after a release
+}
+
+bool ButtonGroup::_chordConfirm(const Chord& c, int64_t ts_ns)
+{
+    // The mask follows debounced edges only: a lost release leaves its bit set,
+    // while the cached state follows the newest kernel edge and has settled by now
+    bool held = true;
+    for (uint64_t m = c.mask; m; m &= m - 1) {
+        const unsigned int bit = static_cast<unsigned int>(__builtin_ctzll(m));
+        Button* btn = _chordMembers[bit];
+        if (btn && btn->get()) continue;
+
+        held = false;
+        if (_pressed.load(std::memory_order_relaxed) & (1ULL << bit)) {
+            _chordEdge(bit, false, ts_ns);      // also disarms c
+        }
+    }
+    return held;
+}
+
+void ButtonGroup::_seedChords(void)
+{
+    uint64_t m = 0;
+    for (const Entry& e : _entries) {
+        if (e.btn->_chordBit >= 0 && e.btn->get()) m |= 1ULL << e.btn->_chordBit;
+    }
+    _pressed.store(m, std::memory_order_relaxed);
+
+    // Chords already held at start must see a fresh press of a member first
+    const uint64_t all = (_chordBits >= 64) ? ~0ULL : ((1ULL << _chordBits) - 1);
+    for (Chord& c : _chords) {
+        _chordWheel.cancel(c.timer);
+        c.active = c.exclusive ? (m & all) == c.mask : (m & c.mask) == c.mask;
+    }
+}
+
+int ButtonGroup::_timeoutMs(int64_t now_ns) const
+{
+    int timeout = _wheel ? _wheel->timeoutMs(now_ns) : -1;
+
+    const int dt = _debounceWheel.timeoutMs(now_ns);
+    if (dt >= 0 && (timeout < 0 || dt < timeout)) timeout = dt;
+
+    const int ct = _chordWheel.timeoutMs(now_ns);
+    if (ct >= 0 && (timeout < 0 || ct < timeout)) timeout = ct;
+
+    const int st = _coalesceWheel.timeoutMs(now_ns);
+    if (st >= 0 && (timeout < 0 || st < timeout)) timeout = st;
+
+    const int wt = _waits.timeoutMs(now_ns);
+    if (wt >= 0 && (timeout < 0 || wt < timeout)) timeout = wt;
+
+    if (!_banks.empty()) {
+        const int64_t d = _nextPoll_ns - now_ns;
+        const int poll_ms = d <= 0 ? 0 : static_cast<int>((d + 999999LL) / 1000000LL);
+        if (timeout < 0 || poll_ms < timeout) timeout = poll_ms;
+    }
+    return timeout;
+}
+
+bool ButtonGroup::_beginPolling(void)
+{
+    if (!_banks.empty()) return true;
+
+    // Bank index and bit of each polled entry, in entry order
+    std::vector<std::pair<size_t, size_t>> where;
+
+    for (Entry& e : _entries) {
+        if (!e.polled) continue;
+
+        // Find a bank with the same chip and bias that still has room
+        PollBank* pb = nullptr;
+        for (PollBank& b : _banks) {
+            const Button* first = b.btns.front();
+            if (first->_chipPath == e.btn->_chipPath && first->_bias == e.btn->_bias &&
+                b.btns.size() < ButtonBank::MAX_BUTTONS) {
+                pb = &b;
+                break;
+            }
+        }
+        if (!pb) {
+            _banks.push_back(PollBank{std::unique_ptr<ButtonBank>(new ButtonBank), {}, 0});
+            pb = &_banks.back();
+        }
+
+        if (pb->bank->add(*e.btn) < 0) {
+            errorMessage = "ButtonGroup: " + pb->bank->errorMessage;
+            _banks.clear();
+            return false;
+        }
+        where.emplace_back(static_cast<size_t>(pb - _banks.data()), pb->btns.size());
+        pb->btns.push_back(e.btn);
+    }
+
+    for (PollBank& b : _banks) {
+        if (!b.bank->begin()) {
+            errorMessage = "ButtonGroup: " + b.bank->errorMessage;
+            _banks.clear();
+            return false;
+        }
+        b.last = b.bank->getMask();
+    }
+
+    size_t k = 0;
+    for (Entry& e : _entries) {
+        if (!e.polled) continue;
+        const PollBank& b = _banks[where[k].first];
+        e.btn->_beginPolled(e.edge, e.debounce_us, e.cb, (b.last >> where[k].second) & 1ULL);
+        e.requested = true;
+        _bindDebouncer(e);
+        ++k;
+    }
+
+    _poll_us = _pollMin_us;
+    _nextPoll_ns = TimerWheel::now() + static_cast<int64_t>(_poll_us) * 1000LL;
+    return true;
+}
+
+void ButtonGroup::_poll(int64_t now_ns)
+{
+    bool changed = false;
+
+    for (PollBank& b : _banks) {
+        bool ok;
+        const uint64_t mask = b.bank->readMask(&ok);
+        if (!ok) continue;
+
+        uint64_t diff = mask ^ b.last;
+        b.last = mask;
+        while (diff) {
+            const unsigned int i = static_cast<unsigned int>(__builtin_ctzll(diff));
+            diff &= diff - 1;
+            b.btns[i]->_pollSample((mask >> i) & 1ULL, now_ns);
+            changed = true;
+        }
+    }
+
+    // Exponential backoff while idle, snap back to the fast rate on activity
+    if (changed) _poll_us = _pollMin_us;
+    else         _poll_us = (_poll_us > _pollMax_us / 2) ? _pollMax_us : _poll_us * 2;
+
+    _nextPoll_ns = now_ns + static_cast<int64_t>(_poll_us) * 1000LL;
+}
+
+void ButtonGroup::_loop(void)
+{
+    Button::_enterThread(_threadOpts);
+
+    epoll_event events[16];
+
+    while (_running.load()) {
+        int n = ::epoll_wait(_epfd, events, 16, _timeoutMs(TimerWheel::now()));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (n == 0) _timerWakeups.store(_timerWakeups.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        for (int i = 0; i < n; ++i) {
+            Button* btn = static_cast<Button*>(events[i].data.ptr);
+            if (!btn) {
+                uint64_t cnt;
+                while (::read(_wakefd, &cnt, sizeof(cnt)) > 0) {}
+                continue;
+            }
+            btn->_stats.add(ButtonStats::Wakeups);
+            if (events[i].events & EPOLLIN) btn->_handleEvents();
+
+            // Level-triggered HUP/ERR would wake the loop forever: drop the fd
+            if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+                ::epoll_ctl(_epfd, EPOLL_CTL_DEL, btn->_eventFd(), nullptr);
+                btn->_lineGone(events[i].events);
+            }
+        }
+
+        _service(TimerWheel::now());
+    }
+}
+
+bool ButtonGroup::_uringArm(Button& btn)
+{
+    const int fd = btn._eventFd();
+    if (fd < 0) return true;
+
+    // Older kernels complete reads on O_NONBLOCK fds with -EAGAIN instead of waiting
+    const int fl = ::fcntl(fd, F_GETFL);
+    if (fl >= 0 && (fl & O_NONBLOCK)) ::fcntl(fd, F_SETFL, fl & ~O_NONBLOCK);
+
+    const unsigned int len = static_cast<unsigned int>(btn._rawBatchBytes());
+    _uringReads.push_back(UringRead{&btn, fd, std::unique_ptr<uint8_t[]>(new uint8_t[len]), len, fl, false});
+    UringRead& r = _uringReads.back();
+    r.posted = _uring.prepRead(r.fd, r.buf.get(), r.len, reinterpret_cast<uint64_t>(&r));
+    return r.posted;
+}
+
+void ButtonGroup::_uringShutdown(void)
+{
+    // A posted read may still write into its buffer: cancel it and wait for its CQE
+    if (_uring.isOpen()) {
+        bool ok = !_wakePosted || _uring.prepCancel(0, URING_CANCEL_TAG);
+        for (UringRead& r : _uringReads) {
+            if (r.posted) ok = _uring.prepCancel(reinterpret_cast<uint64_t>(&r), URING_CANCEL_TAG) && ok;
+        }
+
+        auto outstanding = [this]() {
+            if (_wakePosted) return true;
+            for (const UringRead& r : _uringReads) {
+                if (r.posted) return true;
+            }
+            return false;
+        };
+
+        // Cancelled reads complete promptly; the bound only guards against a wedged ring
+        for (int tries = 0; ok && tries < 100 && outstanding(); ++tries) {
+            if (!_uring.wait(10)) break;
+            _uring.reap([this](uint64_t user_data, int32_t) {
+                if (user_data == URING_CANCEL_TAG) return;
+                if (user_data == 0) { _wakePosted = false; return; }
+                reinterpret_cast<UringRead*>(user_data)->posted = false;     // edges read here are dropped
+            });
+        }
+
+        if (outstanding()) {
+            // Never free memory the kernel may still write: leak the buffers of unreaped reads
+            for (UringRead& r : _uringReads) {
+                if (r.posted) (void)r.buf.release();
+            }
+        }
+    }
+    _uring.close();
+    _wakePosted = false;
+
+    for (UringRead& r : _uringReads) {
+        if (r.flags >= 0 && (r.flags & O_NONBLOCK)) ::fcntl(r.fd, F_SETFL, r.flags);
+    }
+    _uringReads.clear();
+}
+
+void ButtonGroup::_uringForget(Button& btn)
+{
+    {
+        std::lock_guard<std::mutex> lock(_uringLock);
+        for (size_t k = 0; k < _uringPending.size(); ) {
+            if (_uringPending[k] == &btn) _uringPending.erase(_uringPending.begin() + static_cast<std::ptrdiff_t>(k));
+            else ++k;
+        }
+    }
+    for (UringRead& r : _uringReads) {
+        if (r.btn != &btn) continue;
+        r.btn = nullptr;        // its completion is dropped by the loop
+        r.flags = -1;           // the fd is released with the line
+        if (r.posted) _uring.prepCancel(reinterpret_cast<uint64_t>(&r), URING_CANCEL_TAG);
+    }
+}
+
+void ButtonGroup::_service(int64_t now_ns)
+{
+    if (!_banks.empty() && now_ns >= _nextPoll_ns) _poll(now_ns);
+    if (_debouncer.size()) _debounceWheel.advance(now_ns);
+    if (!_chords.empty()) _chordWheel.advance(now_ns);
+    _coalesceWheel.advance(now_ns);
+    if (_wheel) _wheel->advance(now_ns);
+    if (_waits.pending()) _waits.expire(now_ns);
+}
+
+void ButtonGroup::_loopUring(void)
+{
+    Button::_enterThread(_threadOpts);
+
+    // user_data 0 marks the wake fd, anything else is a UringRead* (still posted after _pause())
+    if (!_wakePosted) _wakePosted = _uring.prepRead(_wakefd, &_wakeBuf, sizeof(_wakeBuf), 0);
+    bool ok = _wakePosted;
+    std::vector<Button*> arm;
+
+    while (ok && _running.load()) {
+        {
+            std::lock_guard<std::mutex> lock(_uringLock);
+            arm.swap(_uringPending);
+        }
+        for (Button* btn : arm) ok = _uringArm(*btn) && ok;
+        arm.clear();
+
+        // One syscall submits every re-posted read and waits for the next completions
+        if (!ok || !_uring.wait(_timeoutMs(TimerWheel::now()))) break;
+
+        const unsigned int done = _uring.reap([this, &ok](uint64_t user_data, int32_t res) {
+            if (user_data == 0) {
+                _wakePosted = _uring.prepRead(_wakefd, &_wakeBuf, sizeof(_wakeBuf), 0);
+                ok = _wakePosted && ok;
+                return;
+            }
+
+            if (user_data == URING_CANCEL_TAG) return;
+
+            UringRead* r = reinterpret_cast<UringRead*>(user_data);
+            r->posted = false;
+            if (!r->btn) return;        // removed from the group: retired
+            r->btn->_stats.add(ButtonStats::Wakeups);
+            if (res > 0) r->btn->_processRaw(r->buf.get(), static_cast<size_t>(res));
+
+            // Keep one read posted per line
+            if (res > 0 || res == -EAGAIN || res == -EINTR) {
+                r->posted = _uring.prepRead(r->fd, r->buf.get(), r->len, user_data);
+                ok = r->posted && ok;
+            }
+            else {
+                // A failed read means the line went away: retire it
+                r->btn->_lineGone(res == -ENODEV || res == 0 ? EPOLLHUP : EPOLLERR);
+                if (r->flags >= 0 && (r->flags & O_NONBLOCK)) {
+                    ::fcntl(r->fd, F_SETFL, r->flags);  // hand the fd back as it was armed
+                    r->flags = -1;
+                }
+            }
+        });
+        if (done == 0) _timerWakeups.store(_timerWakeups.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        _service(TimerWheel::now());
+    }
+}
@@ -0,0 +1,569 @@
+/**
+ * @file ButtonGroup.h
+ * @brief Multi-button event manager with one shared event thread.
+ *
+ * Instead of one AUXI poll thread per Button, a ButtonGroup requests the edge
+ * events of every registered Button itself and waits on all of their line
+ * event file descriptors from a single `epoll` loop. Each event is debounced
+ * and dispatched to the callback of the Button it belongs to, so the number
+ * of threads and wakeups stays flat regardless of how many buttons a board has.
+ *
+ * For very large line counts the loop can run on io_uring instead of epoll:
+ * a read stays posted on every line event fd and completions are harvested
+ * in batches, so one io_uring_enter() replaces epoll_wait() plus one read()
+ * per ready fd.
+ *
+ * The group can also detect chords (button combinations held together): the
+ * pressed state of every chord member is one bit of an atomic mask updated
+ * by the event path, and each edge only re-checks the chords containing the
+ * changed button, one AND/compare each.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Include libraries:
+
+#include "Button.h"
+#include "ButtonBank.h"
+#include "ButtonUring.h"
+#include "DebounceEngine.h"
+#include "TimerWheel.h"
+#include <atomic>
+#include <deque>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// #################################################################################
+// ButtonGroup class:
+
+/**
+ * @class ButtonGroup
+ * @brief Registers many Button instances and serves their edge events from one thread.
+ *
+ * Usage:
+ *  - add() each Button with its edge selection, debounce window and callback.
+ *  - begin() requests all lines for events and starts the shared thread.
+ *  - clean() stops the thread and releases every registered line.
+ *
+ * Callbacks are invoked from the shared event thread, one at a time. A slow
+ * callback therefore delays the other buttons of the same group.
+ *
+ * @note Registered Button objects must outlive the group (or its clean()).
+ *       Do not call Button::beginInterrupt() on a Button that is in a group.
+ */
+class ButtonGroup
+{
+    public:
+
+        /**
+         * @brief Wait/read mechanism of the shared event loop.
+         */
+        enum class Backend : uint8_t
+        {
+            Epoll,      ///< epoll_wait() plus one read() per ready line fd (default)
+            IoUring,    ///< Pre-posted io_uring reads, batched completions; fail if unavailable
+            Auto        ///< io_uring if the kernel supports it, otherwise epoll
+        };
+
+        /**
+         * @brief Chord callback.
+         *
+         * @param user Context pointer given to addChord().
+         * @param id   Chord id returned by addChord().
+         */
+        using ChordCallback = void(*)(void* user, unsigned int id);
+
+        /**
+         * @brief Maximum number of distinct buttons taking part in chords.
+         */
+        static constexpr unsigned int MAX_CHORD_BUTTONS = 64;
+
+        /**
+         * @brief Stores last error message (set if an operation fails).
+         */
+        std::string errorMessage;
+
+        ButtonGroup() = default;
+
+        ButtonGroup(const ButtonGroup&) = delete;
+        ButtonGroup& operator=(const ButtonGroup&) = delete;
+
+        /**
+         * @brief Destructor. Calls @ref clean().
+         */
+        ~ButtonGroup();
+
+        /**
+         * @brief Register a button (numeric edge selector).
+         *
+         * If the group is already running, the line is requested and added to
+         * the event loop immediately.
+         *
+         * @param btn          Button to register (must outlive the group).
+         * @param edge         0=Both edges, 1=Rising only, 2=Falling only.
+         * @param debounce_us  Debounce window in microseconds (default 5000).
+         * @param cb           Callback: C-style pointer, bound member or small lambda
+         *                     (may be empty only if the button's event queue is enabled).
+         * @return true on success, false on error (see errorMessage).
+         */
+        bool add(Button& btn, uint8_t edge = 0, uint32_t debounce_us = 5000, ButtonDelegate cb = nullptr);
+
+        /**
+         * @brief Register a button (type-safe overload).
+         *
+         * @param btn          Button to register (must outlive the group).
+         * @param edge         Edge selection (AUXI::Edge::Both/Rising/Falling).
+         * @param debounce_us  Debounce window in microseconds.
+         * @param cb           Callback: C-style pointer, bound member or small lambda
+         *                     (may be empty only if the button's event queue is enabled).
+         * @return true on success, false on error (see errorMessage).
+         */
+        bool add(Button& btn, AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb);
+
+        /**
+         * @brief Register a button with a context-pointer callback.
+         *
+         * @param btn          Button to register (must outlive the group).
+         * @param edge         Edge selection (AUXI::Edge::Both/Rising/Falling).
+         * @param debounce_us  Debounce window in microseconds.
+         * @param cb           Callback receiving @p user as first argument (must not be null).
+         * @param user         Opaque context pointer passed back to @p cb.
+         * @return true on success, false on error (see errorMessage).
+         */
+        bool add(Button& btn, AUXI::Edge edge, uint32_t debounce_us, GpioUserCallback cb, void* user);
+
+        /**
+         * @brief Register a button debounced by the group's shared DebounceEngine.
+         *
+         * Both edges are requested from the kernel so the engine can track
+         * the raw level; @p edge only selects which debounced transitions are
+         * dispatched. Must be called before begin().
+         *
+         * @param btn   Button to register (must outlive the group).
+         * @param edge  Debounced transitions to dispatch (AUXI::Edge::Both/Rising/Falling).
+         * @param cfg   Press/release windows and FirstEdge/Settle mode.
+         * @param cb    Callback: C-style pointer, bound member or small lambda
+         *              (may be empty only if the button's event queue is enabled).
+         * @return true on success, false on error (see errorMessage).
+         */
+        bool add(Button& btn, AUXI::Edge edge, const DebounceConfig& cfg, ButtonDelegate cb);
+
+        /**
+         * @brief Register a polled button debounced by the group's shared DebounceEngine.
+         * @see add(Button&, AUXI::Edge, const DebounceConfig&, ButtonDelegate)
+         */
+        bool addPolled(Button& btn, AUXI::Edge edge, const DebounceConfig& cfg, ButtonDelegate cb);
+
+        /**
+         * @brief Register a button served by polling instead of edge events (numeric edge selector).
+         *
+         * For lines whose chip cannot deliver edge events. Polled buttons are
+         * grouped per chip and bias into bulk requests, so one poll costs one
+         * ioctl per chip. Must be called before begin().
+         *
+         * @param btn          Button to register (must outlive the group).
+         * @param edge         0=Both edges, 1=Rising only, 2=Falling only.
+         * @param debounce_us  Debounce window in microseconds (default 5000).
+         * @param cb           Callback: C-style pointer, bound member or small lambda
+         *                     (may be empty only if the button's event queue is enabled).
+         * @return true on success, false on error (see errorMessage).
+         */
+        bool addPolled(Button& btn, uint8_t edge = 0, uint32_t debounce_us = 5000, ButtonDelegate cb = nullptr);
+
+        /**
+         * @brief Register a button served by polling instead of edge events (type-safe overload).
+         */
+        bool addPolled(Button& btn, AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb);
+
+        /**
+         * @brief Register a chord: fire @p cb once all @p buttons have been held together for @p hold_ms.
+         *
+         * Every button must already be registered with both edges
+         * (AUXI::Edge::Both, or a DebounceConfig entry dispatching both), so
+         * the group sees presses and releases after debounce. The callback
+         * runs on the shared event thread, at most once per hold: releasing
+         * any member re-arms the chord. Chords of different sizes may share
+         * buttons (e.g. 3+7 and 3+7+9); each fires on its own. When the hold
+         * time ends, every member's cached state (newest kernel edge, no
+         * syscall) is checked; a member found released (its debounced release
+         * was lost) is dropped from the mask and the chord does not fire.
+         * Must be called before begin().
+         *
+         * @param buttons   Chord members (2 or more, each registered in this group).
+         * @param hold_ms   Hold time before firing (0 = as soon as the last member is pressed).
+         * @param cb        Callback (must not be null).
+         * @param user      Opaque context pointer passed back to @p cb.
+         * @param exclusive If true, the chord only counts while no other chord member
+         *                  of the group is pressed (3+7 does not fire during 3+7+9).
+         * @return Chord id passed to @p cb, or -1 on error (see errorMessage).
+         */
+        int addChord(std::initializer_list<Button*> buttons, uint32_t hold_ms, ChordCallback cb,
+                     void* user = nullptr, bool exclusive = false);
+
+        /**
+         * @brief Pressed chord members, one bit each (see chordBit()). Any thread, lock-free.
+         */
+        uint64_t pressedMask(void) const;
+
+        /**
+         * @brief Bit of @p btn in pressedMask(), or 0 if it is not a chord member.
+         */
+        uint64_t chordBit(const Button& btn) const;
+
+        /**
+         * @brief Set the adaptive poll period range for polled buttons.
+         *
+         * After any change the period drops to @p min_us; every idle poll
+         * doubles it up to @p max_us. The loop timeout has millisecond
+         * resolution, so periods below 1000 µs are rounded up.
+         *
+         * @param min_us Period right after activity (default 2000).
+         * @param max_us Period when idle (default 200000).
+         */
+        void setPollInterval(uint32_t min_us, uint32_t max_us);
+
+        /**
+         * @brief Drive a timer wheel from the shared event thread.
+         *
+         * The loop sleeps until the earliest armed deadline (or indefinitely if
+         * none is armed) and fires due timers after every wakeup, so timer
+         * callbacks run on the same thread as the button callbacks. Must be set
+         * before begin(); pass nullptr to detach.
+         *
+         * @param wheel Timer wheel (e.g. GestureEngine::timers()), must outlive the group.
+         */
+        void setTimerWheel(TimerWheel* wheel);
+
+        /**
+         * @brief Set scheduling options for the shared event thread.
+         *
+         * Takes effect on the next begin(); if the options cannot be applied,
+         * begin() fails and reports why in errorMessage.
+         *
+         * @param opts Policy/priority, CPU affinity, memory locking, stack prefault and name.
+         */
+        void setThreadOptions(const ButtonThreadOptions& opts);
+
+        /**
+         * @brief Select the event loop backend.
+         *
+         * Takes effect on the next begin(). io_uring needs Linux ≥ 5.11
+         * (IORING_FEAT_EXT_ARG); callbacks, debounce and timers behave the
+         * same with either backend.
+         *
+         * @param backend Epoll (default), IoUring or Auto.
+         */
+        void setBackend(Backend backend);
+
+        /**
+         * @brief True if the running loop uses io_uring.
+         */
+        bool usingIoUring(void) const;
+
+        /**
+         * @brief Request all registered lines for events and start the shared thread.
+         * @return true on success, false on error (see errorMessage).
+         */
+        bool begin(void);
+
+        /**
+         * @brief Request all registered lines in parallel, one worker per chip, and start the thread.
+         *
+         * Line requests block in the kernel (slow on I2C/SPI expanders), so
+         * lines of different chips are requested concurrently; lines of one
+         * chip are requested by one worker on the shared chip handle. A failing
+         * line does not stop the others: the thread is started with every
+         * button that could be requested, and each failed Button keeps its
+         * code in lastError() and its reason in errorMessage. Calling
+         * beginAll() again (after stop()) retries only the failed lines.
+         *
+         * @param maxThreads Upper bound on worker threads (0 = one per chip).
+         * @return true if every button is running; false if any failed (see errorMessage,
+         *         which lists the failed lines) or the thread could not be started.
+         */
+        bool beginAll(unsigned int maxThreads = 0);
+
+        /**
+         * @brief Stop the shared event thread (no-op if not running).
+         *
+         * Lines stay requested; begin() can be called again to resume.
+         */
+        void stop(void);
+
+        /**
+         * @brief Unregister one button and release its line.
+         *
+         * A running loop is only paused for the change: the other buttons
+         * keep their lines, queued kernel events, pending awaits, chord holds
+         * and debounce windows. Awaits pending on @p btn complete as timed
+         * out. Removing a polled button re-requests its bank's lines.
+         *
+         * @return true if @p btn was registered.
+         */
+        bool remove(Button& btn);
+
+        /**
+         * @brief Stop the thread, release every registered line and forget all buttons.
+         */
+        void clean(void);
+
+        /**
+         * @brief Number of registered buttons.
+         */
+        size_t size(void) const;
+
+        /**
+         * @brief Append the counters of every registered button in Prometheus text format.
+         *
+         * One `counter` family per ButtonStatsSnapshot field
+         * (`<prefix>_edges_total`, `_bounces_total`, `_callbacks_total`,
+         * `_queue_overflows_total`, `_wakeups_total`, `_syscalls_total`),
+         * labelled with `chip` and `line`. Safe while the group runs, but call
+         * it from the thread that calls add(); it allocates, so keep it off
+         * the event thread.
+         *
+         * @param out    Destination (appended to).
+         * @param prefix Metric name prefix.
+         */
+        void writePrometheus(std::string& out, const char* prefix = "button") const;
+
+        /**
+         * @brief True while the shared event thread is running.
+         */
+        bool running(void) const;
+
+        /**
+         * @brief Loop wakeups caused by a timeout instead of a line event or stop().
+         *
+         * The loop only uses a timeout while a timer (debounce, chord, gesture
+         * wheel), an await deadline or a polled button is pending, so without
+         * polled buttons this stays constant while no button is touched.
+         * Any thread.
+         */
+        uint64_t timerWakeups(void) const;
+
+    private:
+
+        friend class Button;
+
+        /**
+         * @brief Registration record of one button.
+         */
+        struct Entry
+        {
+            Button*      btn;               ///< Registered button
+            AUXI::Edge   edge;              ///< Requested edge selection
+            uint32_t     debounce_us;       ///< Software debounce window
+            ButtonDelegate cb;              ///< Callback for accepted edges
+            bool         requested;         ///< True once the line is requested and in epoll (or polled)
+            bool         polled;            ///< Served by the poller instead of edge events
+            int32_t      debounceId;        ///< Input id in _debouncer, -1 = Button's own window
+        };
+
+        /**
+         * @brief Bulk-read set of polled buttons sharing one chip and bias.
+         */
+        struct PollBank
+        {
+            std::unique_ptr<ButtonBank> bank;   ///< Bulk request
+            std::vector<Button*>        btns;   ///< Buttons in bit order
+            uint64_t                    last;   ///< Last LOGICAL mask
+        };
+
+        std::vector<Entry>  _entries;               ///< Registered buttons
+        int                 _epfd = -1;             ///< epoll instance
+        int                 _wakefd = -1;           ///< eventfd used to wake the loop on stop()
+        std::thread         _thread;                ///< Shared event thread
+        ButtonThreadOptions _threadOpts;            ///< Options applied to _thread
+        std::atomic<bool>   _running{false};        ///< Loop run flag
+        TimerWheel*         _wheel = nullptr;       ///< Optional timer wheel driven by the loop
+        std::atomic<uint64_t> _timerWakeups{0};     ///< Timeout wakeups (written by the loop only)
+
+        ButtonWaitList      _waits;                 ///< Awaits of the buttons served by _thread
+        TimerWheel          _debounceWheel{100};    ///< Deadlines of _debouncer (100 µs ticks)
+        DebounceEngine      _debouncer{_debounceWheel}; ///< Shared debouncer for DebounceConfig entries
+        std::vector<Button*> _debounced;            ///< Button of each _debouncer input id
+        std::vector<AUXI::Edge> _debouncedEdge;     ///< Dispatched transitions of each input id
+
+        /**
+         * @brief One registered chord.
+         */
+        struct Chord
+        {
+            ButtonGroup*        group;      ///< Owning group (timer context)
+            unsigned int        id;         ///< Chord id passed to cb
+            uint64_t            mask;       ///< Member bits
+            int64_t             hold_ns;    ///< Hold time before firing
+            ChordCallback       cb;         ///< Callback
+            void*               user;       ///< Callback context
+            bool                exclusive;  ///< Other chord members must be released
+            bool                active;     ///< Currently held (timer armed or already fired)
+            TimerWheel::Timer   timer;      ///< Hold timer in _chordWheel
+        };
+
+        std::deque<Chord>   _chords;                ///< Registered chords (stable addresses = timer ctx)
+        std::vector<Chord*> _chordsOf[MAX_CHORD_BUTTONS];   ///< Chords to re-check when bit i changes
+        Button*             _chordMembers[MAX_CHORD_BUTTONS] = {};  ///< Button of each chord bit (nullptr once removed)
+        unsigned int        _chordBits = 0;         ///< Bits handed out to chord members
+        std::atomic<uint64_t> _pressed{0};          ///< Pressed chord members (written by the loop only)
+        TimerWheel          _chordWheel{1000};      ///< Chord hold timers (1 ms ticks)
+        TimerWheel          _coalesceWheel{100};    ///< Button::setCoalescing() window closes (100 µs ticks)
+
+        /**
+         * @brief Pre-posted io_uring read of one line event fd.
+         */
+        struct UringRead
+        {
+            Button*                     btn;    ///< Button owning the fd (nullptr once removed: completion dropped)
+            int                         fd;     ///< Line event fd
+            std::unique_ptr<uint8_t[]>  buf;    ///< Raw kernel event buffer
+            unsigned int                len;    ///< Size of buf
+            int                         flags;  ///< fd status flags before arming (O_NONBLOCK restored on retire)
+            bool                        posted; ///< True while a read into buf is queued or in flight
+        };
+
+        Backend             _backend = Backend::Epoll;  ///< Requested backend
+        bool                _useUring = false;      ///< io_uring backend active (set by begin())
+        ButtonUring         _uring;                 ///< Ring (loop thread only)
+        std::deque<UringRead> _uringReads;          ///< Posted reads (stable addresses = user_data)
+        std::mutex          _uringLock;             ///< Guards _uringPending
+        std::vector<Button*> _uringPending;         ///< Buttons whose read must be posted by the loop
+        static constexpr uint64_t URING_CANCEL_TAG = ~0ULL;    ///< user_data of IORING_OP_ASYNC_CANCEL requests
+        uint64_t            _wakeBuf = 0;           ///< Target of the posted wake fd read
+        bool                _wakePosted = false;    ///< True while the wake fd read is queued or in flight
+
+        std::vector<PollBank> _banks;               ///< Polled buttons, per chip and bias
+        uint32_t            _pollMin_us = 2000;     ///< Poll period after activity
+        uint32_t            _pollMax_us = 200000;   ///< Poll period when idle
+        uint32_t            _poll_us = 2000;        ///< Current poll period
+        int64_t             _nextPoll_ns = 0;       ///< Deadline of the next poll
+
+        /**
+         * @brief Create the epoll instance and wake eventfd if not done yet.
+         */
+        bool _open(void);
+
+        /**
+         * @brief Request the line of an entry and register its fd in epoll (or queue its io_uring read).
+         */
+        bool _attach(Entry& e);
+
+        /**
+         * @brief Register the fd of an already requested entry in epoll (or queue its io_uring read).
+         */
+        bool _register(Entry& e);
+
+        /**
+         * @brief Open epoll/wake fd and select the backend (first half of begin()).
+         */
+        bool _prepare(void);
+
+        /**
+         * @brief Hand requested entries to the loop and start the thread (second half of begin()).
+         */
+        bool _start(void);
+
+        /**
+         * @brief Join the loop thread, leaving waits, chords, timers and posted reads in place.
+         * @return true if the loop was running (resume it with _resume()).
+         */
+        bool _pause(void);
+
+        /**
+         * @brief Restart the loop thread after _pause() or from _start().
+         */
+        bool _resume(void);
+
+        /**
+         * @brief Re-point every reference to @p from at @p to (loop paused or stopped; Button move).
+         */
+        void _relocate(Button* from, Button* to);
+
+        /**
+         * @brief Hook a requested/polled entry up to the shared debouncer.
+         */
+        void _bindDebouncer(Entry& e);
+
+        /**
+         * @brief DebounceEngine callback: dispatch a debounced change to its Button.
+         */
+        static void _onDebounced(void* ctx, uint32_t id, bool state, int64_t ts_ns);
+
+        /**
+         * @brief Debounced edge of chord member @p bit: update _pressed and (dis)arm its chords.
+         */
+        void _chordEdge(unsigned int bit, bool pressed, int64_t ts_ns);
+
+        /**
+         * @brief Hold timer expiry: fire the chord.
+         */
+        static void _onChordTimer(void* ctx);
+
+        /**
+         * @brief Check the members of @p c when its hold timer ends (O(members), no syscall);
+         *        released members are fed to _chordEdge() as releases.
+         * @return true if every member is still pressed.
+         */
+        bool _chordConfirm(const Chord& c, int64_t ts_ns);
+
+        /**
+         * @brief Seed _pressed from the cached button states (before the loop starts).
+         */
+        void _seedChords(void);
+
+        /**
+         * @brief Loop timeout: earliest of timer wheels and next poll (-1 = none).
+         */
+        int _timeoutMs(int64_t now_ns) const;
+
+        /**
+         * @brief Build and request the bulk banks of all polled entries.
+         */
+        bool _beginPolling(void);
+
+        /**
+         * @brief Sample every bank once and dispatch changes; adapts the poll period.
+         */
+        void _poll(int64_t now_ns);
+
+        /**
+         * @brief Post the first io_uring read of a button's line event fd (loop thread).
+         */
+        bool _uringArm(Button& btn);
+
+        /**
+         * @brief Retire every posted io_uring read, then close the ring (loop thread joined).
+         *
+         * Each read is cancelled and its completion reaped before the buffers
+         * are freed, and each line fd gets its O_NONBLOCK flag back.
+         */
+        void _uringShutdown(void);
+
+        /**
+         * @brief Detach @p btn from the io_uring loop (loop paused): its pending arm is
+         *        dropped and its posted read cancelled; the buffer stays until shutdown.
+         */
+        void _uringForget(Button& btn);
+
+        /**
+         * @brief Poll, timers and await deadlines due at @p now_ns (after every wakeup).
+         */
+        void _service(int64_t now_ns);
+
+        /**
+         * @brief Shared event loop body (epoll backend).
+         */
+        void _loop(void);
+
+        /**
+         * @brief Shared event loop body (io_uring backend).
+         */
+        void _loopUring(void);
+};
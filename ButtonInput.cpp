@@ -0,0 +1,139 @@
+// #######################################################################
+// Include Libraries:
+
+#include "ButtonBackend.h"
+#include "ButtonChip.h"
+#if BUTTON_BACKEND == BUTTON_BACKEND_GPIOD_V1
+#include <gpiod.h>
+#endif
+#include <cerrno>
+#include <cstring>
+#include <linux/gpio.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+// #######################################################################
+// ButtonInput class:
+
+ButtonInput::ButtonInput(const char* path, unsigned int pin, uint8_t mode, uint8_t bias)
+    : _path(path ? path : ""), _pin(pin), _mode(mode), _bias(bias)
+{
+}
+
+ButtonInput::~ButtonInput()
+{
+    clean();
+}
+
+bool ButtonInput::begin(void)
+{
+    if (_fd >= 0 || _line) return true;
+
+    _chip = ButtonChipCache::acquire(_path);
+    int err = 0;
+
+#if BUTTON_BACKEND == BUTTON_BACKEND_GPIOD_V1
+    // libgpiod 1.x so plain inputs keep working on kernels without uAPI v2
+    gpiod_chip* gchip = ButtonChipCache::gpiod(_chip, err);
+    if (!gchip) {
+        clean();
+        errorMessage = "failed to open " + _path + ": " + std::strerror(err);
+        return false;
+    }
+
+    gpiod_line* line = gpiod_chip_get_line(gchip, _pin);
+    gpiod_line_request_config req{};
+    req.consumer = "Button";
+    req.request_type = GPIOD_LINE_REQUEST_DIRECTION_INPUT;
+    switch (_bias) {
+        case 1:  req.flags = GPIOD_LINE_REQUEST_FLAG_BIAS_PULL_DOWN; break;
+        case 2:  req.flags = GPIOD_LINE_REQUEST_FLAG_BIAS_PULL_UP;   break;
+        default: req.flags = GPIOD_LINE_REQUEST_FLAG_BIAS_DISABLE;   break;
+    }
+
+    if (!line || gpiod_line_request(line, &req, 0) < 0) {
+        err = errno;
+        clean();
+        errorMessage = "failed to request line " + std::to_string(_pin) + ": " + std::strerror(err);
+        return false;
+    }
+    _line = line;
+#else
+    const int chipfd = ButtonChipCache::fd(_chip, err);
+    if (chipfd < 0) {
+        clean();
+        errorMessage = "failed to open " + _path + ": " + std::strerror(err);
+        return false;
+    }
+
+    gpio_v2_line_request req{};
+    req.offsets[0] = _pin;
+    req.num_lines = 1;
+    std::strncpy(req.consumer, "Button", sizeof(req.consumer) - 1);
+
+    uint64_t flags = GPIO_V2_LINE_FLAG_INPUT;
+    switch (_bias) {
+        case 1:  flags |= GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN; break;
+        case 2:  flags |= GPIO_V2_LINE_FLAG_BIAS_PULL_UP;   break;
+        default: flags |= GPIO_V2_LINE_FLAG_BIAS_DISABLED;  break;
+    }
+    req.config.flags = flags;
+
+    if (::ioctl(chipfd, GPIO_V2_GET_LINE_IOCTL, &req) < 0) {
+        err = errno;
+        clean();
+        errorMessage = "failed to request line " + std::to_string(_pin) + ": " + std::strerror(err);
+        return false;
+    }
+    _fd = req.fd;
+#endif
+    read();
+    return true;
+}
+
+void ButtonInput::stopInterrupt(void)
+{
+}
+
+void ButtonInput::clean(void)
+{
+#if BUTTON_BACKEND == BUTTON_BACKEND_GPIOD_V1
+    if (_line) {
+        gpiod_line_release(_line);
+        _line = nullptr;
+    }
+#endif
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+    if (_chip) {
+        ButtonChipCache::release(_chip);
+        _chip = nullptr;
+    }
+}
+
+int ButtonInput::value(void)
+{
+#if BUTTON_BACKEND == BUTTON_BACKEND_GPIOD_V1
+    if (_line) return gpiod_line_get_value(_line);
+#endif
+    if (_fd < 0) return -1;
+
+    gpio_v2_line_values vals{};
+    vals.mask = 1;
+    if (::ioctl(_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &vals) < 0) return -1;
+    return static_cast<int>(vals.bits & 1);
+}
+
+bool ButtonInput::read(void)
+{
+    const int v = value();
+    if (v >= 0) _state = (_mode == 0) ? (v == 0) : (v == 1);
+    return _state;
+}
+
+bool ButtonInput::get(void) const
+{
+    return _state;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file ButtonInput.h
+ * @brief Plain GPIO input on the shared chip, the line Button::begin() requests.
+ *
+ * ButtonInput has the part of the AUXI interface Button relies on (Edge,
+ * errorMessage, begin(), value(), read(), get(), stopInterrupt(), clean()).
+ * Button uses it for its plain input in every backend, and outside
+ * BUTTON_BACKEND_GPIOD_V1 ButtonBackend.h makes `AUXI` an alias of it, so
+ * Buttons built without AUXIO and libgpiod 1.x keep the same API. The line
+ * is requested as an input with the chosen bias through ButtonChipCache
+ * (libgpiod 1.x in BUTTON_BACKEND_GPIOD_V1, raw uAPI v2 ioctls otherwise);
+ * polarity is applied in software, like AUXI.
+ *
+ * Include ButtonBackend.h (or Button.h), not this header.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Include libraries:
+
+#include <cstdint>
+#include <string>
+
+struct ButtonChip;
+struct gpiod_line;
+
+// #################################################################################
+// ButtonInput class:
+
+/**
+ * @class ButtonInput
+ * @brief One GPIO line requested as an input (polled reads only).
+ */
+class ButtonInput
+{
+    public:
+
+        /**
+         * @brief Edge selection (same values as AUXI::Edge).
+         */
+        enum class Edge : uint8_t
+        {
+            Both,       ///< Rising and falling edges
+            Rising,     ///< Rising edges only
+            Falling     ///< Falling edges only
+        };
+
+        /**
+         * @brief Stores last error message (set if begin() fails).
+         */
+        std::string errorMessage;
+
+        /**
+         * @brief Describe the line; nothing is requested until begin().
+         * @param path Chip device path (e.g., "/dev/gpiochip0").
+         * @param pin  Line offset on that chip.
+         * @param mode Polarity: 1=active-high, 0=active-low.
+         * @param bias 0=off, 1=pull-down, 2=pull-up.
+         */
+        ButtonInput(const char* path, unsigned int pin, uint8_t mode, uint8_t bias);
+
+        ButtonInput(const ButtonInput&) = delete;
+        ButtonInput& operator=(const ButtonInput&) = delete;
+
+        /**
+         * @brief Destructor. Calls @ref clean().
+         */
+        ~ButtonInput();
+
+        /**
+         * @brief Request the line as an input (no-op if already requested).
+         * @return true on success, false on failure (see @ref errorMessage).
+         */
+        bool begin(void);
+
+        /**
+         * @brief No-op: ButtonInput has no interrupt thread (Button owns the event path).
+         */
+        void stopInterrupt(void);
+
+        /**
+         * @brief Release the line (safe to call multiple times).
+         */
+        void clean(void);
+
+        /**
+         * @brief RAW line level: 0/1, or -1 on error or if not begun.
+         */
+        int value(void);
+
+        /**
+         * @brief LOGICAL (polarity-applied) state; updates the cached state.
+         */
+        bool read(void);
+
+        /**
+         * @brief Cached LOGICAL state of the last read() (no hardware access).
+         */
+        bool get(void) const;
+
+    private:
+
+        std::string  _path;             ///< Chip device path
+        unsigned int _pin;              ///< Line offset
+        uint8_t      _mode;             ///< Polarity: 1=active-high, 0=active-low
+        uint8_t      _bias;             ///< Bias: 0=off, 1=pull-down, 2=pull-up
+        ButtonChip*  _chip = nullptr;   ///< Shared chip of the request (ButtonChipCache)
+        int          _fd = -1;          ///< uAPI v2 line request fd (-1 = none)
+        gpiod_line*  _line = nullptr;   ///< libgpiod 1.x line request (BUTTON_BACKEND_GPIOD_V1 only)
+        bool         _state = false;    ///< Last LOGICAL state
+};
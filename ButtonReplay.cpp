@@ -0,0 +1,192 @@
+// #######################################################################
+// Include Libraries:
+
+#include "ButtonReplay.h"
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// #######################################################################
+// Helpers:
+
+static int64_t monotonicNs(void)
+{
+    timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+static void sleepUntilNs(int64_t deadline_ns)
+{
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(deadline_ns / 1000000000LL);
+    ts.tv_nsec = static_cast<long>(deadline_ns % 1000000000LL);
+    while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+}
+
+// #######################################################################
+// ButtonReplay class:
+
+ButtonReplay::~ButtonReplay()
+{
+    close();
+}
+
+bool ButtonReplay::open(const char* path)
+{
+    close();
+
+    const int fd = path ? ::open(path, O_RDONLY | O_CLOEXEC) : -1;
+    if (fd < 0) {
+        errorMessage = std::string("ButtonReplay: failed to open ") + (path ? path : "(null)") + ".";
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) < sizeof(ButtonTraceHeader)) {
+        errorMessage = "ButtonReplay: not a trace file (too short).";
+        ::close(fd);
+        return false;
+    }
+
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    const int err = errno;
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        errorMessage = std::string("ButtonReplay: mmap failed: ") + std::strerror(err);
+        return false;
+    }
+
+    // size >= the header (checked above); dividing first keeps a hostile capacity from overflowing
+    const ButtonTraceHeader* hdr = static_cast<const ButtonTraceHeader*>(map);
+    if (std::memcmp(hdr->magic, BUTTON_TRACE_MAGIC, sizeof(hdr->magic)) != 0 ||
+        (hdr->version != BUTTON_TRACE_VERSION && hdr->version != 1) || hdr->recordSize != sizeof(ButtonTraceRecord) ||
+        hdr->capacity == 0 ||
+        hdr->capacity > (size - sizeof(ButtonTraceHeader)) / sizeof(ButtonTraceRecord)) {
+        errorMessage = "ButtonReplay: bad trace header (magic, version, record size or capacity).";
+        ::munmap(map, size);
+        return false;
+    }
+
+    _hdr = hdr;
+    _recs = reinterpret_cast<const ButtonTraceRecord*>(hdr + 1);
+    _mapSize = size;
+    _anyChip = hdr->version == 1;
+
+    // After a wrap the oldest record sits right after the newest one
+    const uint64_t written = hdr->written;
+    _count = written < hdr->capacity ? written : hdr->capacity;
+    _first = written - _count;
+    return true;
+}
+
+void ButtonReplay::close(void)
+{
+    detach();
+    if (_hdr) {
+        ::munmap(const_cast<ButtonTraceHeader*>(_hdr), _mapSize);
+        _hdr = nullptr;
+    }
+    _recs = nullptr;
+    _mapSize = 0;
+    _first = 0;
+    _count = 0;
+    _anyChip = false;
+}
+
+bool ButtonReplay::attach(Button& btn, AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb)
+{
+    if (!cb && !btn._queue) {
+        errorMessage = "ButtonReplay: callback is null.";
+        return false;
+    }
+    const uint16_t chip = buttonTraceChip(btn._chipPath);
+    if (_find(chip, btn._pin)) {
+        errorMessage = "ButtonReplay: line " + std::to_string(btn._pin) + " of " + btn._chipPath + " is already attached.";
+        return false;
+    }
+
+    // Same pipeline as a polled button: no line request, state comes from the trace
+    btn._beginPolled(edge, debounce_us, cb, false);
+    _targets.push_back(Target{&btn, edge, chip});
+    return true;
+}
+
+void ButtonReplay::detach(void)
+{
+    for (Target& t : _targets) t.btn->_evPolled = false;
+    _targets.clear();
+}
+
+size_t ButtonReplay::size(void) const
+{
+    return static_cast<size_t>(_count);
+}
+
+size_t ButtonReplay::run(double speed)
+{
+    if (!_hdr || _count == 0 || _targets.empty()) return 0;
+
+    const int64_t t0 = static_cast<int64_t>(_at(0).ts_ns);
+    const int64_t start = monotonicNs();
+
+    // Every run starts from a clean debounce window (earlier runs used other timestamps)
+    for (Target& t : _targets) t.btn->_evLast_ns = -1;
+
+    ButtonEvent batch[Button::EVENT_BATCH];
+    size_t n = 0;
+    Target* cur = nullptr;
+    size_t delivered = 0;
+
+    auto flush = [&]() {
+        if (n == 0) return;
+        cur->btn->_processBatch(batch, n);
+        delivered += n;
+        n = 0;
+    };
+
+    for (uint64_t i = 0; i < _count; ++i) {
+        const ButtonTraceRecord& r = _at(i);
+        Target* t = _find(r.chip, r.line);
+        if (!t) continue;
+        if ((t->edge == AUXI::Edge::Rising && !r.rising) || (t->edge == AUXI::Edge::Falling && r.rising)) continue;
+
+        // Recorded spacing is kept in the timestamps, only the wall-clock pace scales
+        const int64_t off = static_cast<int64_t>(r.ts_ns) - t0;
+        if (speed > 0.0) {
+            const int64_t due = start + static_cast<int64_t>(static_cast<double>(off) / speed);
+            if (due > monotonicNs()) {
+                flush();
+                sleepUntilNs(due);
+            }
+        }
+
+        // Batch consecutive edges of one line, like a kernel FIFO read
+        if (t != cur || n == Button::EVENT_BATCH) {
+            flush();
+            cur = t;
+        }
+        const int64_t ts = start + off;
+        batch[n++] = ButtonEvent::make(r.rising != 0, r.line, static_cast<uint64_t>(ts));
+    }
+    flush();
+    return delivered;
+}
+
+const ButtonTraceRecord& ButtonReplay::_at(uint64_t i) const
+{
+    return _recs[(_first + i) % _hdr->capacity];
+}
+
+ButtonReplay::Target* ButtonReplay::_find(uint16_t chip, uint32_t line)
+{
+    for (Target& t : _targets) {
+        if (t.btn->_pin == line && (_anyChip || t.chip == chip)) return &t;
+    }
+    return nullptr;
+}
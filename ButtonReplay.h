@@ -0,0 +1,133 @@
+/**
+ * @file ButtonReplay.h
+ * @brief Replays a ButtonTraceRecorder file through the Button debounce/dispatch pipeline.
+ *
+ * Recorded raw edges are routed by chip index and line offset to the
+ * attached Button instances and enter the same path kernel edges take (state cache, edge
+ * filter, debounce, event queue, latency stats, callback, awaits), batched
+ * like kernel reads. Timestamps are shifted to the replay start while keeping
+ * the recorded spacing, so debounce decisions are identical at every speed.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Include libraries:
+
+#include "Button.h"
+#include "ButtonTrace.h"
+#include <vector>
+
+// #################################################################################
+// ButtonReplay class:
+
+/**
+ * @class ButtonReplay
+ * @brief Feeds a recorded edge trace to Button handlers at 1x, Nx or maximum speed.
+ *
+ * Usage:
+ *  - open() a trace file.
+ *  - attach() each Button with the edge selection, debounce and callback to test.
+ *  - run() on the calling thread; callbacks run there too.
+ *
+ * Attached buttons need no hardware (no line is requested); read()/get()
+ * report the replayed state. Call detach() (or close()) before using them on
+ * real lines again.
+ */
+class ButtonReplay
+{
+    public:
+
+        /**
+         * @brief Stores last error message (set if an operation fails).
+         */
+        std::string errorMessage;
+
+        ButtonReplay() = default;
+
+        ButtonReplay(const ButtonReplay&) = delete;
+        ButtonReplay& operator=(const ButtonReplay&) = delete;
+
+        /**
+         * @brief Destructor. Calls @ref close().
+         */
+        ~ButtonReplay();
+
+        /**
+         * @brief Map a trace file read-only and validate its header.
+         * @return true on success, false on error (see errorMessage).
+         */
+        bool open(const char* path);
+
+        /**
+         * @brief Detach every Button and unmap the trace.
+         */
+        void close(void);
+
+        /**
+         * @brief Route the records of @p btn's chip and line offset to @p btn.
+         *
+         * The chip index comes from @p btn's chip path (buttonTraceChip()).
+         * Version 1 traces carry no chip index; their records are matched by
+         * line offset only.
+         *
+         * @param btn          Button to drive (must outlive the replay or its close()).
+         * @param edge         Edge selection, applied as the kernel would.
+         * @param debounce_us  Software debounce window in microseconds.
+         * @param cb           Callback (may be empty only if the event queue is enabled).
+         * @return true on success, false on error (see errorMessage).
+         */
+        bool attach(Button& btn, AUXI::Edge edge, uint32_t debounce_us, ButtonDelegate cb);
+
+        /**
+         * @brief Stop routing to every attached Button.
+         */
+        void detach(void);
+
+        /**
+         * @brief Number of records in the trace (oldest to newest).
+         */
+        size_t size(void) const;
+
+        /**
+         * @brief Replay the whole trace on the calling thread.
+         *
+         * @param speed Time scale: 1.0 = recorded pace, 10.0 = ten times faster,
+         *              0 = as fast as possible (no sleeping, full batches).
+         *              Latency histograms are only meaningful at 1.0.
+         * @return Number of records delivered to attached buttons.
+         */
+        size_t run(double speed = 1.0);
+
+    private:
+
+        /**
+         * @brief Attached Button and its edge filter.
+         */
+        struct Target
+        {
+            Button*     btn;        ///< Driven button
+            AUXI::Edge  edge;       ///< Edge selection
+            uint16_t    chip;       ///< Chip index of btn (buttonTraceChip())
+        };
+
+        const ButtonTraceHeader*  _hdr = nullptr;   ///< Mapped header
+        const ButtonTraceRecord*  _recs = nullptr;  ///< Mapped ring
+        size_t                    _mapSize = 0;     ///< Size of the mapping
+        uint64_t                  _first = 0;       ///< Index of the oldest record
+        uint64_t                  _count = 0;       ///< Records in the trace
+        bool                      _anyChip = false; ///< Version 1 trace: records carry no chip
+        std::vector<Target>       _targets;         ///< Attached buttons
+
+        /**
+         * @brief Record @p i in chronological order.
+         */
+        const ButtonTraceRecord& _at(uint64_t i) const;
+
+        /**
+         * @brief Target for @p line of @p chip, or nullptr.
+         */
+        Target* _find(uint16_t chip, uint32_t line);
+};
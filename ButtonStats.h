@@ -0,0 +1,131 @@
+/**
+ * @file ButtonStats.h
+ * @brief Per-button work counters of the event path.
+ *
+ * Every Button keeps one ButtonStats block: raw edges, debounce rejections,
+ * dispatched callbacks, event thread wakeups and syscalls issued on its
+ * behalf. Each counter lives on its own cache line and is bumped with a
+ * relaxed load/store by the single thread serving the button, so counting
+ * costs no locked instruction and readers never bounce the writer's lines.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Include libraries:
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// #################################################################################
+// ButtonStats class:
+
+/**
+ * @brief Point-in-time copy of the counters of one Button.
+ */
+struct ButtonStatsSnapshot
+{
+    uint64_t    edges = 0;      ///< Raw edges seen (kernel events, or level changes when polled)
+    uint64_t    bounces = 0;    ///< Edges rejected by software debounce
+    uint64_t    callbacks = 0;  ///< Accepted edges dispatched (callback / queue / awaits)
+    uint64_t    overflows = 0;  ///< Events dropped because the event queue was full
+    uint64_t    wakeups = 0;    ///< Times an event loop woke up to serve this button
+    uint64_t    syscalls = 0;   ///< read()/ioctl()/poll() calls issued for this button
+};
+
+/**
+ * @class ButtonStats
+ * @brief Cache-line separated relaxed counters (one writer, any readers).
+ *
+ * add() must only be called by the thread currently serving the button
+ * (its own event thread, the ButtonGroup thread, an external loop or a
+ * replay). snapshot() may be called from any thread at any time.
+ */
+class ButtonStats
+{
+    public:
+
+        /**
+         * @brief Counter selector.
+         */
+        enum Counter : unsigned int
+        {
+            Edges,              ///< Raw edges entering the pipeline
+            Accepted,           ///< Edges that passed debounce (bounces = Edges - Accepted)
+            Callbacks,          ///< Dispatched events
+            Wakeups,            ///< Event loop wakeups
+            Syscalls,           ///< Syscalls issued
+            COUNT               ///< Number of counters
+        };
+
+        ButtonStats() = default;
+
+        ButtonStats(const ButtonStats&) = delete;
+        ButtonStats& operator=(const ButtonStats&) = delete;
+
+        /**
+         * @brief Add @p n to counter @p c (serving thread only; no locked instruction).
+         */
+        void add(Counter c, uint64_t n = 1) noexcept
+        {
+            std::atomic<uint64_t>& v = _slots[c].value;
+            v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Current value of counter @p c.
+         */
+        uint64_t get(Counter c) const noexcept
+        {
+            return _slots[c].value.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Copy all counters (overflows are filled in by the owner).
+         */
+        ButtonStatsSnapshot snapshot(void) const noexcept
+        {
+            ButtonStatsSnapshot s;
+            s.edges = get(Edges);
+            const uint64_t accepted = get(Accepted);
+            s.bounces = s.edges > accepted ? s.edges - accepted : 0;
+            s.callbacks = get(Callbacks);
+            s.wakeups = get(Wakeups);
+            s.syscalls = get(Syscalls);
+            return s;
+        }
+
+        /**
+         * @brief Take over the counters of @p from and zero them (no thread may serve either).
+         */
+        void transfer(ButtonStats& from) noexcept
+        {
+            for (unsigned int i = 0; i < COUNT; ++i) {
+                _slots[i].value.store(from._slots[i].value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                from._slots[i].value.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Zero every counter (only while no thread serves the button).
+         */
+        void reset(void) noexcept
+        {
+            for (Slot& s : _slots) s.value.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+
+        /**
+         * @brief One counter padded to a full cache line.
+         */
+        struct alignas(64) Slot
+        {
+            std::atomic<uint64_t> value{0};     ///< Counter value
+        };
+
+        Slot _slots[COUNT];     ///< Counters, one cache line each
+};
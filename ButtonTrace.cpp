@@ -0,0 +1,110 @@
+// #######################################################################
+// Include Libraries:
+
+#include "ButtonTrace.h"
+#include "Button.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// #######################################################################
+// Helpers:
+
+uint16_t buttonTraceChip(const std::string& path)
+{
+    size_t i = path.size();
+    while (i > 0 && path[i - 1] >= '0' && path[i - 1] <= '9') --i;
+    if (i == path.size() || path.size() - i > 5) return BUTTON_TRACE_NO_CHIP;
+
+    uint32_t n = 0;
+    for (; i < path.size(); ++i) n = n * 10 + static_cast<uint32_t>(path[i] - '0');
+    return n < BUTTON_TRACE_NO_CHIP ? static_cast<uint16_t>(n) : BUTTON_TRACE_NO_CHIP;
+}
+
+// #######################################################################
+// ButtonTraceRecorder class:
+
+ButtonTraceRecorder::~ButtonTraceRecorder()
+{
+    close();
+}
+
+bool ButtonTraceRecorder::open(const char* path, size_t capacity)
+{
+    close();
+
+    if (!path || capacity == 0) {
+        errorMessage = "ButtonTraceRecorder: path is null or capacity is 0.";
+        return false;
+    }
+
+    const int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        errorMessage = std::string("ButtonTraceRecorder: failed to open ") + path + ": " + std::strerror(errno);
+        return false;
+    }
+
+    const size_t size = sizeof(ButtonTraceHeader) + capacity * sizeof(ButtonTraceRecord);
+    if (::ftruncate(fd, static_cast<off_t>(size)) < 0) {
+        errorMessage = std::string("ButtonTraceRecorder: ftruncate failed: ") + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    // MAP_POPULATE: no page faults on the event thread later
+    void* map = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    const int err = errno;
+    ::close(fd);    // the mapping keeps the file alive
+    if (map == MAP_FAILED) {
+        errorMessage = std::string("ButtonTraceRecorder: mmap failed: ") + std::strerror(err);
+        return false;
+    }
+
+    _hdr = static_cast<ButtonTraceHeader*>(map);
+    _recs = reinterpret_cast<ButtonTraceRecord*>(_hdr + 1);
+    _capacity = capacity;
+    _mapSize = size;
+
+    std::memset(_hdr, 0, sizeof(*_hdr));
+    std::memcpy(_hdr->magic, BUTTON_TRACE_MAGIC, sizeof(_hdr->magic));
+    _hdr->version = BUTTON_TRACE_VERSION;
+    _hdr->recordSize = sizeof(ButtonTraceRecord);
+    _hdr->capacity = capacity;
+    return true;
+}
+
+void ButtonTraceRecorder::close(void)
+{
+    if (!_hdr) return;
+
+    ::msync(_hdr, _mapSize, MS_SYNC);
+    ::munmap(_hdr, _mapSize);
+    _hdr = nullptr;
+    _recs = nullptr;
+    _capacity = 0;
+    _mapSize = 0;
+}
+
+void ButtonTraceRecorder::record(const ButtonEvent& ev, uint16_t chip)
+{
+    if (!_hdr) return;
+
+    const uint64_t idx = __atomic_fetch_add(&_hdr->written, 1, __ATOMIC_RELAXED);
+    ButtonTraceRecord& r = _recs[idx % _capacity];
+    r.ts_ns = ev.ts_ns;
+    r.line = ev.line;
+    r.rising = ev.rising ? 1 : 0;
+    r.chip = chip;
+}
+
+uint64_t ButtonTraceRecorder::written(void) const
+{
+    return _hdr ? __atomic_load_n(&_hdr->written, __ATOMIC_RELAXED) : 0;
+}
+
+size_t ButtonTraceRecorder::capacity(void) const
+{
+    return _capacity;
+}
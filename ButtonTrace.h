@@ -0,0 +1,141 @@
+/**
+ * @file ButtonTrace.h
+ * @brief Compact binary edge trace and a memory-mapped ring recorder.
+ *
+ * A trace file is one 64-byte ButtonTraceHeader followed by a ring of
+ * 16-byte ButtonTraceRecord entries. Buttons with a recorder attached
+ * (Button::setTraceRecorder()) append every raw edge before debounce, so a
+ * ButtonReplay of the file drives the same debounce and dispatch pipeline
+ * again. Recording is one atomic add plus one 16-byte store into a shared
+ * mapping: no syscall, no lock, no allocation.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Include libraries:
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct ButtonEvent;
+
+// #################################################################################
+// Trace file format:
+
+/**
+ * @brief Trace file header (first 64 bytes of the file, host byte order).
+ */
+struct ButtonTraceHeader
+{
+    char        magic[8];       ///< "BTNTRACE"
+    uint32_t    version;        ///< Format version (2; version 1 records carry no chip)
+    uint32_t    recordSize;     ///< sizeof(ButtonTraceRecord)
+    uint64_t    capacity;       ///< Ring size in records
+    uint64_t    written;        ///< Records ever written; ring slot = index % capacity
+    uint8_t     reserved[32];   ///< Zero
+};
+
+/**
+ * @brief One raw edge as recorded.
+ */
+struct ButtonTraceRecord
+{
+    uint64_t    ts_ns;          ///< Kernel timestamp in ns (ButtonEvent::ts_ns)
+    uint32_t    line;           ///< GPIO line offset
+    uint8_t     rising;         ///< 1 = rising, 0 = falling (LOGICAL)
+    uint8_t     reserved;       ///< Zero
+    uint16_t    chip;           ///< Chip index (N of /dev/gpiochipN, see buttonTraceChip())
+};
+
+static_assert(sizeof(ButtonTraceHeader) == 64, "ButtonTraceHeader must be 64 bytes");
+static_assert(sizeof(ButtonTraceRecord) == 16, "ButtonTraceRecord must be 16 bytes");
+
+/**
+ * @brief Magic bytes of ButtonTraceHeader::magic.
+ */
+constexpr char BUTTON_TRACE_MAGIC[8] = {'B', 'T', 'N', 'T', 'R', 'A', 'C', 'E'};
+
+/**
+ * @brief Current ButtonTraceHeader::version.
+ */
+constexpr uint32_t BUTTON_TRACE_VERSION = 2;
+
+/**
+ * @brief ButtonTraceRecord::chip of a path that does not end in a chip number.
+ */
+constexpr uint16_t BUTTON_TRACE_NO_CHIP = 0xffff;
+
+/**
+ * @brief Chip index recorded for @p path: the trailing number of /dev/gpiochipN.
+ * @return N, or BUTTON_TRACE_NO_CHIP if @p path does not end in a number below 0xffff.
+ */
+uint16_t buttonTraceChip(const std::string& path);
+
+// #################################################################################
+// ButtonTraceRecorder class:
+
+/**
+ * @class ButtonTraceRecorder
+ * @brief Appends raw edges to a memory-mapped ring file.
+ *
+ * Safe to share between several event threads: slots are claimed with an
+ * atomic add. When the ring is full the oldest records are overwritten, so
+ * the file always holds the newest `capacity` edges. The mapping is shared,
+ * so the data survives a crash of the recording process.
+ */
+class ButtonTraceRecorder
+{
+    public:
+
+        /**
+         * @brief Stores last error message (set if an operation fails).
+         */
+        std::string errorMessage;
+
+        ButtonTraceRecorder() = default;
+
+        ButtonTraceRecorder(const ButtonTraceRecorder&) = delete;
+        ButtonTraceRecorder& operator=(const ButtonTraceRecorder&) = delete;
+
+        /**
+         * @brief Destructor. Calls @ref close().
+         */
+        ~ButtonTraceRecorder();
+
+        /**
+         * @brief Create (or truncate) @p path and map a ring of @p capacity records.
+         * @return true on success, false on error (see errorMessage).
+         */
+        bool open(const char* path, size_t capacity = 65536);
+
+        /**
+         * @brief Flush and unmap the file.
+         */
+        void close(void);
+
+        /**
+         * @brief Append one edge of chip @p chip (wait-free; no-op if not open).
+         */
+        void record(const ButtonEvent& ev, uint16_t chip = BUTTON_TRACE_NO_CHIP);
+
+        /**
+         * @brief Records written since open() (may exceed capacity()).
+         */
+        uint64_t written(void) const;
+
+        /**
+         * @brief Ring size in records (0 if not open).
+         */
+        size_t capacity(void) const;
+
+    private:
+
+        ButtonTraceHeader*  _hdr = nullptr;     ///< Mapped header
+        ButtonTraceRecord*  _recs = nullptr;    ///< Mapped ring
+        size_t              _capacity = 0;      ///< Ring size in records
+        size_t              _mapSize = 0;       ///< Size of the mapping
+};
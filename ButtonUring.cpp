@@ -0,0 +1,235 @@
+// #######################################################################
+// Include Libraries:
+
+#include "ButtonUring.h"
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// #######################################################################
+// Helpers:
+
+static int uringSetup(unsigned int entries, io_uring_params* p)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+static int uringEnter(int fd, unsigned int to_submit, unsigned int min_complete, unsigned int flags,
+                      const void* arg, size_t argsz)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, argsz));
+}
+
+// #######################################################################
+// ButtonUring class:
+
+ButtonUring::~ButtonUring()
+{
+    close();
+}
+
+bool ButtonUring::open(unsigned int entries)
+{
+    if (_fd >= 0) return true;
+
+    // The CQ must hold one completion per pre-posted read plus slack
+    io_uring_params p;
+    std::memset(&p, 0, sizeof(p));
+    p.flags = IORING_SETUP_CQSIZE;
+    p.cq_entries = entries * 2;
+
+    _fd = uringSetup(entries, &p);
+    if (_fd < 0) {
+        errorMessage = std::string("ButtonUring: io_uring_setup failed: ") + std::strerror(errno);
+        return false;
+    }
+    if (!(p.features & IORING_FEAT_NODROP) || !(p.features & IORING_FEAT_EXT_ARG)) {
+        errorMessage = "ButtonUring: kernel lacks IORING_FEAT_NODROP/EXT_ARG (need Linux >= 5.11).";
+        close();
+        return false;
+    }
+
+    _sqMapSize = p.sq_off.array + p.sq_entries * sizeof(unsigned int);
+    _cqMapSize = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    const bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single && _cqMapSize > _sqMapSize) _sqMapSize = _cqMapSize;
+
+    _sqMap = ::mmap(nullptr, _sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+    if (_sqMap == MAP_FAILED) {
+        _sqMap = nullptr;
+        errorMessage = std::string("ButtonUring: mmap SQ ring failed: ") + std::strerror(errno);
+        close();
+        return false;
+    }
+
+    if (single) {
+        _cqMap = _sqMap;
+    } else {
+        _cqMap = ::mmap(nullptr, _cqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+        if (_cqMap == MAP_FAILED) {
+            _cqMap = nullptr;
+            errorMessage = std::string("ButtonUring: mmap CQ ring failed: ") + std::strerror(errno);
+            close();
+            return false;
+        }
+    }
+
+    _sqesSize = p.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = ::mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        errorMessage = std::string("ButtonUring: mmap SQEs failed: ") + std::strerror(errno);
+        close();
+        return false;
+    }
+    _sqes = static_cast<io_uring_sqe*>(sqes);
+
+    char* sq = static_cast<char*>(_sqMap);
+    _sqHead    = reinterpret_cast<unsigned int*>(sq + p.sq_off.head);
+    _sqTail    = reinterpret_cast<unsigned int*>(sq + p.sq_off.tail);
+    _sqArray   = reinterpret_cast<unsigned int*>(sq + p.sq_off.array);
+    _sqMask    = *reinterpret_cast<unsigned int*>(sq + p.sq_off.ring_mask);
+    _sqEntries = *reinterpret_cast<unsigned int*>(sq + p.sq_off.ring_entries);
+
+    char* cq = static_cast<char*>(_cqMap);
+    _cqHead = reinterpret_cast<unsigned int*>(cq + p.cq_off.head);
+    _cqTail = reinterpret_cast<unsigned int*>(cq + p.cq_off.tail);
+    _cqMask = *reinterpret_cast<unsigned int*>(cq + p.cq_off.ring_mask);
+    _cqes   = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+
+    _toSubmit = 0;
+    return true;
+}
+
+void ButtonUring::close(void)
+{
+    if (_sqes) { ::munmap(_sqes, _sqesSize); _sqes = nullptr; }
+    if (_cqMap && _cqMap != _sqMap) ::munmap(_cqMap, _cqMapSize);
+    _cqMap = nullptr;
+    if (_sqMap) { ::munmap(_sqMap, _sqMapSize); _sqMap = nullptr; }
+    if (_fd >= 0) { ::close(_fd); _fd = -1; }
+
+    _sqHead = _sqTail = _sqArray = nullptr;
+    _cqHead = _cqTail = nullptr;
+    _cqes = nullptr;
+    _toSubmit = 0;
+}
+
+bool ButtonUring::isOpen(void) const
+{
+    return _fd >= 0;
+}
+
+bool ButtonUring::prepRead(int fd, void* buf, unsigned int len, uint64_t user_data)
+{
+    io_uring_sqe* sqe = _nextSqe();
+    if (!sqe) return false;
+
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(buf);
+    sqe->len = len;
+    sqe->off = static_cast<uint64_t>(-1);       // current position (stream fds)
+    sqe->user_data = user_data;
+    _pushSqe();
+    return true;
+}
+
+bool ButtonUring::prepCancel(uint64_t target, uint64_t user_data)
+{
+    io_uring_sqe* sqe = _nextSqe();
+    if (!sqe) return false;
+
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = target;                         // user_data of the request to cancel
+    sqe->user_data = user_data;
+    _pushSqe();
+    return true;
+}
+
+bool ButtonUring::wait(int timeout_ms)
+{
+    if (_fd < 0) {
+        errorMessage = "ButtonUring: ring is not open.";
+        return false;
+    }
+
+    __kernel_timespec ts;
+    io_uring_getevents_arg arg;
+    std::memset(&arg, 0, sizeof(arg));
+    if (timeout_ms >= 0) {
+        ts.tv_sec = timeout_ms / 1000;
+        ts.tv_nsec = static_cast<long long>(timeout_ms % 1000) * 1000000LL;
+        arg.ts = reinterpret_cast<uint64_t>(&ts);
+    }
+
+    // One syscall: submit every re-posted read and wait for the next completions
+    int rc = uringEnter(_fd, _toSubmit, timeout_ms == 0 ? 0 : 1,
+                        IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+    if (rc >= 0) {
+        _toSubmit -= static_cast<unsigned int>(rc) < _toSubmit ? static_cast<unsigned int>(rc) : _toSubmit;
+        return true;
+    }
+    if (errno == ETIME || errno == EINTR || errno == EBUSY) return true;
+
+    errorMessage = std::string("ButtonUring: io_uring_enter failed: ") + std::strerror(errno);
+    return false;
+}
+
+bool ButtonUring::supported(void)
+{
+    ButtonUring probe;
+    return probe.open(4);
+}
+
+bool ButtonUring::_submit(void)
+{
+    int rc = uringEnter(_fd, _toSubmit, 0, 0, nullptr, 0);
+    if (rc < 0) {
+        errorMessage = std::string("ButtonUring: io_uring_enter failed: ") + std::strerror(errno);
+        return false;
+    }
+    _toSubmit -= static_cast<unsigned int>(rc) < _toSubmit ? static_cast<unsigned int>(rc) : _toSubmit;
+    return true;
+}
+
+io_uring_sqe* ButtonUring::_nextSqe(void)
+{
+    if (_fd < 0) {
+        errorMessage = "ButtonUring: ring is not open.";
+        return nullptr;
+    }
+
+    unsigned int tail = *_sqTail;
+    if (tail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) >= _sqEntries) {
+        if (!_submit()) return nullptr;
+        tail = *_sqTail;
+        if (tail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) >= _sqEntries) {
+            errorMessage = "ButtonUring: submission queue is full.";
+            return nullptr;
+        }
+    }
+
+    io_uring_sqe* sqe = &_sqes[tail & _sqMask];
+    std::memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+void ButtonUring::_pushSqe(void)
+{
+    const unsigned int tail = *_sqTail;
+    const unsigned int idx = tail & _sqMask;
+    _sqArray[idx] = idx;
+    __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+    ++_toSubmit;
+}
+
+void ButtonUring::_cqe(unsigned int idx, uint64_t& user_data, int32_t& res) const
+{
+    user_data = _cqes[idx].user_data;
+    res = _cqes[idx].res;
+}
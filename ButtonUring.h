@@ -0,0 +1,188 @@
+/**
+ * @file ButtonUring.h
+ * @brief Minimal io_uring ring (raw syscalls, no liburing) for the ButtonGroup event loop.
+ *
+ * Only what the group needs: pre-posted IORING_OP_READ requests on the line
+ * event fds, one io_uring_enter() that submits every re-posted read and
+ * waits for completions with a timeout, and batched completion harvesting.
+ * With many lines this replaces one epoll_wait() plus one read() per ready
+ * fd by a single syscall per loop iteration.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Include libraries:
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+// #################################################################################
+// ButtonUring class:
+
+/**
+ * @class ButtonUring
+ * @brief Single-threaded io_uring submission/completion ring.
+ *
+ * Requires IORING_FEAT_NODROP and IORING_FEAT_EXT_ARG (Linux ≥ 5.11); open()
+ * fails otherwise so the caller can fall back to epoll. All methods must be
+ * called from the thread that owns the ring.
+ */
+class ButtonUring
+{
+    public:
+
+        /**
+         * @brief Stores last error message (set if an operation fails).
+         */
+        std::string errorMessage;
+
+        ButtonUring() = default;
+
+        ButtonUring(const ButtonUring&) = delete;
+        ButtonUring& operator=(const ButtonUring&) = delete;
+
+        /**
+         * @brief Destructor. Calls @ref close().
+         */
+        ~ButtonUring();
+
+        /**
+         * @brief Create the ring and map its queues.
+         * @param entries Submission queue size (rounded up to a power of two by the kernel).
+         * @return true on success, false on error (see errorMessage).
+         */
+        bool open(unsigned int entries);
+
+        /**
+         * @brief Unmap and close the ring.
+         *
+         * The kernel cancels outstanding requests asynchronously, after the
+         * fd is gone: cancel and reap them first (prepCancel()) if their
+         * buffers are about to be freed.
+         */
+        void close(void);
+
+        /**
+         * @brief True between a successful open() and close().
+         */
+        bool isOpen(void) const;
+
+        /**
+         * @brief Queue a read of up to @p len bytes from @p fd (submitted by wait()).
+         *
+         * If the submission queue is full the queued entries are submitted
+         * first.
+         *
+         * @return true on success, false on error (see errorMessage).
+         */
+        bool prepRead(int fd, void* buf, unsigned int len, uint64_t user_data);
+
+        /**
+         * @brief Queue an IORING_OP_ASYNC_CANCEL of the request tagged @p target (submitted by wait()).
+         *
+         * The cancelled request still completes with its own CQE (-ECANCELED,
+         * or its result if it finished first); the cancel itself completes
+         * with @p user_data.
+         *
+         * @return true on success, false on error (see errorMessage).
+         */
+        bool prepCancel(uint64_t target, uint64_t user_data);
+
+        /**
+         * @brief Submit queued reads and wait for at least one completion.
+         * @param timeout_ms Maximum wait in ms (-1 = forever, 0 = do not wait).
+         * @return true on success, timeout or signal; false on error (see errorMessage).
+         */
+        bool wait(int timeout_ms);
+
+        /**
+         * @brief Harvest all available completions.
+         *
+         * @p fn is called as `fn(uint64_t user_data, int32_t res)` for each one;
+         * the CQ head is advanced once after the whole batch.
+         *
+         * @return Number of completions harvested.
+         */
+        template <typename Fn>
+        unsigned int reap(Fn fn);
+
+        /**
+         * @brief True if the running kernel accepts io_uring_setup() (probe ring).
+         */
+        static bool supported(void);
+
+    private:
+
+        int             _fd = -1;               ///< Ring fd
+
+        void*           _sqMap = nullptr;       ///< SQ ring mapping (also CQ with SINGLE_MMAP)
+        size_t          _sqMapSize = 0;         ///< Size of _sqMap
+        void*           _cqMap = nullptr;       ///< CQ ring mapping (== _sqMap with SINGLE_MMAP)
+        size_t          _cqMapSize = 0;         ///< Size of _cqMap
+        io_uring_sqe*   _sqes = nullptr;        ///< SQE array
+        size_t          _sqesSize = 0;          ///< Size of _sqes mapping
+
+        unsigned int*   _sqHead = nullptr;      ///< Kernel-owned SQ head
+        unsigned int*   _sqTail = nullptr;      ///< User-owned SQ tail
+        unsigned int*   _sqArray = nullptr;     ///< SQ index array
+        unsigned int    _sqMask = 0;            ///< SQ ring mask
+        unsigned int    _sqEntries = 0;         ///< SQ ring size
+
+        unsigned int*   _cqHead = nullptr;      ///< User-owned CQ head
+        unsigned int*   _cqTail = nullptr;      ///< Kernel-owned CQ tail
+        unsigned int    _cqMask = 0;            ///< CQ ring mask
+        io_uring_cqe*   _cqes = nullptr;        ///< CQE array
+
+        unsigned int    _toSubmit = 0;          ///< SQEs queued since the last enter
+
+        /**
+         * @brief Submit queued SQEs without waiting (used when the SQ is full).
+         */
+        bool _submit(void);
+
+        /**
+         * @brief Next free SQE, zeroed (submits queued ones first if the SQ is full); nullptr on error.
+         */
+        io_uring_sqe* _nextSqe(void);
+
+        /**
+         * @brief Make the SQE returned by _nextSqe() visible to the kernel.
+         */
+        void _pushSqe(void);
+
+        /**
+         * @brief user_data and res of CQE @p idx.
+         */
+        void _cqe(unsigned int idx, uint64_t& user_data, int32_t& res) const;
+};
+
+// #################################################################################
+// ButtonUring template implementation:
+
+template <typename Fn>
+unsigned int ButtonUring::reap(Fn fn)
+{
+    if (_fd < 0) return 0;
+
+    unsigned int head = *_cqHead;
+    const unsigned int tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+    unsigned int n = 0;
+
+    while (head != tail) {
+        uint64_t user_data;
+        int32_t res;
+        _cqe(head & _cqMask, user_data, res);
+        fn(user_data, res);
+        ++head;
+        ++n;
+    }
+    __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+    return n;
+}
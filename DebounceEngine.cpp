@@ -0,0 +1,124 @@
+// #######################################################################
+// Include Libraries:
+
+#include "DebounceEngine.h"
+
+// #######################################################################
+// DebounceEngine class:
+
+DebounceEngine::DebounceEngine(TimerWheel& wheel)
+: _wheel(wheel)
+{}
+
+void DebounceEngine::setCallback(Callback cb, void* ctx)
+{
+    _cb = cb;
+    _ctx = ctx;
+}
+
+uint32_t DebounceEngine::add(const DebounceConfig& cfg, bool initial)
+{
+    // Windows are stored in ns as 32-bit values: clamp to ~4.29 s
+    auto toNs = [](uint32_t us) -> uint32_t {
+        const uint64_t ns = static_cast<uint64_t>(us) * 1000ULL;
+        return ns > 0xffffffffULL ? 0xffffffffU : static_cast<uint32_t>(ns);
+    };
+
+    const uint32_t id = static_cast<uint32_t>(_nodes.size());
+    _press_ns.push_back(toNs(cfg.press_us));
+    _release_ns.push_back(toNs(cfg.release_us));
+    _mode.push_back(static_cast<uint8_t>(cfg.mode));
+    _stable.push_back(initial ? 1 : 0);
+    _raw.push_back(initial ? 1 : 0);
+    _rawTs.push_back(0);
+    _lockUntil.push_back(0);
+    _nodes.push_back(Node{});
+
+    // Deque growth never moves a node, so armed timers of other inputs stay linked
+    Node& n = _nodes.back();
+    n.timer.fn = &DebounceEngine::_onTimer;
+    n.timer.ctx = &n;
+    n.engine = this;
+    n.id = id;
+    return id;
+}
+
+void DebounceEngine::reset(uint32_t id, bool state)
+{
+    if (id >= _nodes.size()) return;
+    _wheel.cancel(_nodes[id].timer);
+    _stable[id] = _raw[id] = state ? 1 : 0;
+    _lockUntil[id] = 0;
+}
+
+void DebounceEngine::onEdge(uint32_t id, bool rising, int64_t ts_ns)
+{
+    if (id >= _nodes.size()) return;
+
+    _raw[id] = rising ? 1 : 0;
+    _rawTs[id] = ts_ns;
+
+    if (static_cast<DebounceMode>(_mode[id]) == DebounceMode::Settle) {
+        // Every edge restarts the window of the new level
+        _wheel.schedule(_nodes[id].timer, ts_ns + _window(id, rising));
+        return;
+    }
+
+    // FirstEdge: inside a lock-out only the raw level is tracked (timer re-checks it)
+    if (ts_ns < _lockUntil[id]) return;
+    if (_raw[id] == _stable[id]) return;
+
+    _report(id, rising, ts_ns);
+    _lockUntil[id] = ts_ns + _window(id, rising);
+    _wheel.schedule(_nodes[id].timer, _lockUntil[id]);
+}
+
+void DebounceEngine::clear(void)
+{
+    for (Node& n : _nodes) _wheel.cancel(n.timer);
+    _press_ns.clear();
+    _release_ns.clear();
+    _mode.clear();
+    _stable.clear();
+    _raw.clear();
+    _rawTs.clear();
+    _lockUntil.clear();
+    _nodes.clear();
+}
+
+size_t DebounceEngine::size(void) const
+{
+    return _nodes.size();
+}
+
+void DebounceEngine::_report(uint32_t id, bool state, int64_t ts_ns)
+{
+    _stable[id] = state ? 1 : 0;
+    if (_cb) _cb(_ctx, id, state, ts_ns);
+}
+
+uint32_t DebounceEngine::_window(uint32_t id, bool state) const
+{
+    return state ? _press_ns[id] : _release_ns[id];
+}
+
+void DebounceEngine::_onTimer(void* ctx)
+{
+    Node& n = *static_cast<Node*>(ctx);
+    DebounceEngine& e = *n.engine;
+    const uint32_t id = n.id;
+
+    if (e._raw[id] == e._stable[id]) return;    // settled back to the reported level
+
+    const bool state = e._raw[id] != 0;
+    if (static_cast<DebounceMode>(e._mode[id]) == DebounceMode::Settle) {
+        e._report(id, state, e._rawTs[id]);
+        return;
+    }
+
+    // FirstEdge lock-out ended on the other level: report it and lock again
+    const int64_t now = n.timer.deadline_ns;
+    e._report(id, state, e._rawTs[id]);
+    e._lockUntil[id] = now + e._window(id, state);
+    e._wheel.schedule(n.timer, e._lockUntil[id]);
+}
@@ -0,0 +1,147 @@
+/**
+ * @file DebounceEngine.h
+ * @brief Shared software debounce for many inputs on one timer wheel.
+ *
+ * Per-input state is kept in a struct-of-arrays layout (one compact array
+ * per field), and every settle / lock-out deadline is a timer in a single
+ * hierarchical TimerWheel, so handling an edge costs O(1) regardless of how
+ * many inputs are registered. Press and release can use different windows.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Include libraries:
+
+#include "TimerWheel.h"
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// #################################################################################
+
+/**
+ * @brief When a debounced input reports a change.
+ */
+enum class DebounceMode : uint8_t
+{
+    FirstEdge,  ///< Report the first edge at once, then ignore bounces for the window
+    Settle      ///< Report only after the input was stable for the whole window
+};
+
+/**
+ * @brief Debounce windows of one input.
+ */
+struct DebounceConfig
+{
+    uint32_t     press_us = 5000;                   ///< Window for press (rising) transitions
+    uint32_t     release_us = 5000;                 ///< Window for release (falling) transitions
+    DebounceMode mode = DebounceMode::FirstEdge;    ///< Emit on first edge or on settle
+};
+
+// #################################################################################
+// DebounceEngine class:
+
+/**
+ * @class DebounceEngine
+ * @brief O(1)-per-edge debounce state machines sharing one timer wheel.
+ *
+ * FirstEdge: a change is reported immediately and the input is locked for
+ * the window of the new state; if the raw level differs from the reported
+ * one when the lock ends, that final level is reported too, so a short
+ * press is never lost.
+ *
+ * Settle: every edge restarts the window of the new raw level; the level is
+ * reported (with the timestamp of its last edge) once it held for the window.
+ *
+ * @note Not thread-safe: edges and the wheel must be driven from one thread.
+ *       Inputs may be added while timers of other inputs are armed.
+ */
+class DebounceEngine
+{
+    public:
+
+        /**
+         * @brief Debounced change callback.
+         *
+         * @param ctx   Context pointer given to setCallback().
+         * @param id    Input id returned by add().
+         * @param state New debounced LOGICAL state.
+         * @param ts_ns CLOCK_MONOTONIC timestamp of the edge that produced it.
+         */
+        using Callback = void(*)(void* ctx, uint32_t id, bool state, int64_t ts_ns);
+
+        /**
+         * @brief Construct an engine on a timer wheel.
+         * @param wheel Timer wheel driving the deadlines (must outlive the engine).
+         */
+        explicit DebounceEngine(TimerWheel& wheel);
+
+        DebounceEngine(const DebounceEngine&) = delete;
+        DebounceEngine& operator=(const DebounceEngine&) = delete;
+
+        /**
+         * @brief Set the debounced change callback.
+         */
+        void setCallback(Callback cb, void* ctx);
+
+        /**
+         * @brief Add an input.
+         * @param cfg     Windows and mode.
+         * @param initial Initial LOGICAL state.
+         * @return Input id.
+         */
+        uint32_t add(const DebounceConfig& cfg, bool initial);
+
+        /**
+         * @brief Set the current state of an input without reporting it (e.g. after a line request).
+         */
+        void reset(uint32_t id, bool state);
+
+        /**
+         * @brief Feed one raw edge (O(1)).
+         */
+        void onEdge(uint32_t id, bool rising, int64_t ts_ns);
+
+        /**
+         * @brief Cancel all pending deadlines and remove every input.
+         */
+        void clear(void);
+
+        /**
+         * @brief Number of inputs.
+         */
+        size_t size(void) const;
+
+    private:
+
+        /**
+         * @brief Wheel node of one input (the only per-input record that is not SoA).
+         */
+        struct Node
+        {
+            TimerWheel::Timer   timer;      ///< Settle / lock-out deadline
+            DebounceEngine*     engine;     ///< Owning engine
+            uint32_t            id;         ///< Input id
+        };
+
+        TimerWheel&             _wheel;         ///< Shared timer wheel
+        Callback                _cb = nullptr;  ///< Change callback
+        void*                   _ctx = nullptr; ///< Change callback context
+
+        // Struct-of-arrays per-input state
+        std::vector<uint32_t>   _press_ns;      ///< Press window in ns (fits: max ~4.29 s)
+        std::vector<uint32_t>   _release_ns;    ///< Release window in ns
+        std::vector<uint8_t>    _mode;          ///< DebounceMode
+        std::vector<uint8_t>    _stable;        ///< Last reported state
+        std::vector<uint8_t>    _raw;           ///< Latest raw state
+        std::vector<int64_t>    _rawTs;         ///< Timestamp of the latest raw edge
+        std::vector<int64_t>    _lockUntil;     ///< FirstEdge: end of the current lock-out
+        std::deque<Node>        _nodes;         ///< Wheel nodes (stable addresses = armed timer ctx)
+
+        void _report(uint32_t id, bool state, int64_t ts_ns);
+        uint32_t _window(uint32_t id, bool state) const;
+        static void _onTimer(void* ctx);
+};
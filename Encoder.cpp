@@ -0,0 +1,393 @@
+// #######################################################################
+// Include Libraries:
+
+#include "Encoder.h"
+#include "ButtonChip.h"
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+// #######################################################################
+// Helpers:
+
+static int64_t monotonicNs(void)
+{
+    timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+/**
+ * @brief Count change for [previous state << 2 | new state] (bit 0 = A, bit 1 = B).
+ *
+ * Forward is 00 -> 01 -> 11 -> 10 -> 00 (A leads B). Entries where both
+ * channels changed at once are 0: a single event only ever changes one line.
+ */
+static const int8_t QUADRATURE_LUT[16] = {
+     0, +1, -1,  0,
+    -1,  0,  0, +1,
+    +1,  0,  0, -1,
+     0, -1, +1,  0
+};
+
+// #######################################################################
+// Encoder class:
+
+Encoder::Encoder(const std::string& chipPath, unsigned int pinA, unsigned int pinB, uint8_t bias)
+    : _chipPath(chipPath), _pinA(pinA), _pinB(pinB), _bias(bias)
+{
+}
+
+Encoder::~Encoder()
+{
+    clean();
+}
+
+void Encoder::setStepsPerDetent(unsigned int steps)
+{
+    _steps = steps ? steps : 1;
+}
+
+void Encoder::setCallback(EncoderCallback cb, void* user)
+{
+    _cb = cb;
+    _user = user;
+}
+
+void Encoder::setThreadOptions(const ButtonThreadOptions& opts)
+{
+    _threadOpts = opts;
+}
+
+bool Encoder::begin(uint32_t debounce_us)
+{
+    if (!beginEvents(debounce_us)) return false;
+
+    _wakeFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_wakeFd < 0) {
+        const int err = errno;
+        clean();
+        return _fail(ButtonError::EventFd, err);
+    }
+
+    if (_threadOpts.lockMemory && ::mlockall(MCL_CURRENT | MCL_FUTURE) < 0) {
+        const int err = errno;
+        clean();
+        return _fail(ButtonError::MemoryLock, err);
+    }
+
+    _running.store(true);
+    _thread = std::thread(&Encoder::_loop, this);
+
+    int err = 0;
+    const ButtonError e = Button::_applyThreadOptions(_thread, _threadOpts, err);
+    if (e != ButtonError::None) {
+        clean();
+        return _fail(e, err);
+    }
+    return true;
+}
+
+bool Encoder::beginEvents(uint32_t debounce_us)
+{
+    clean();
+    _lastError = ButtonError::None;
+    _lastErrno = 0;
+    _gone.store(0, std::memory_order_relaxed);
+
+    if (_pinA == _pinB) {
+        errorMessage = "Encoder: channels A and B must be different lines.";
+        _lastError = ButtonError::LineRequest;
+        return false;
+    }
+    return _request(debounce_us);
+}
+
+int Encoder::eventFd(void) const
+{
+    return _fd;
+}
+
+size_t Encoder::processPendingEvents(void)
+{
+    if (_fd < 0) return 0;
+
+    gpio_v2_line_event raw[EVENT_BATCH];
+    size_t total = 0;
+
+    // Drain the FIFO: a short read means the kernel had no more queued
+    for (;;) {
+        const ssize_t r = ::read(_fd, raw, sizeof(raw));
+        if (r <= 0) break;
+        const size_t n = static_cast<size_t>(r) / sizeof(gpio_v2_line_event);
+        _decode(raw, n);
+        total += n;
+        if (n < EVENT_BATCH) break;
+    }
+    return total;
+}
+
+void Encoder::stop(void)
+{
+    if (_running.exchange(false)) {
+        uint64_t one = 1;
+        if (::write(_wakeFd, &one, sizeof(one)) < 0) {
+            // The loop also re-checks the flag after every wakeup
+        }
+    }
+    if (_thread.joinable()) _thread.join();
+
+    if (_wakeFd >= 0) {
+        ::close(_wakeFd);
+        _wakeFd = -1;
+    }
+}
+
+void Encoder::clean(void)
+{
+    stop();
+
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+    if (_chip) {
+        ButtonChipCache::release(_chip);
+        _chip = nullptr;
+    }
+}
+
+int64_t Encoder::count(void) const
+{
+    return _count.load(std::memory_order_relaxed);
+}
+
+int64_t Encoder::position(void) const
+{
+    return count() / static_cast<int64_t>(_steps);
+}
+
+double Encoder::velocity(void) const
+{
+    const int64_t last = _lastTs.load(std::memory_order_relaxed);
+    if (last == 0 || monotonicNs() - last > IDLE_NS) return 0.0;
+    return _velocity.load(std::memory_order_relaxed);
+}
+
+void Encoder::reset(int64_t count)
+{
+    _count.store(count, std::memory_order_relaxed);
+    _velocity.store(0.0, std::memory_order_relaxed);
+    _lastTs.store(0, std::memory_order_relaxed);
+    _velHead = 0;
+    _velFill = 0;
+}
+
+uint64_t Encoder::errors(void) const
+{
+    return _errors.load(std::memory_order_relaxed);
+}
+
+uint64_t Encoder::overflows(void) const
+{
+    return _overflows.load(std::memory_order_relaxed);
+}
+
+ButtonError Encoder::lastError(void) const
+{
+    if (_gone.load(std::memory_order_acquire)) return ButtonError::LineGone;
+    return _lastError;
+}
+
+int Encoder::lastErrno(void) const
+{
+    const int gone = _gone.load(std::memory_order_acquire);
+    return gone ? gone : _lastErrno;
+}
+
+bool Encoder::_fail(ButtonError e, int err)
+{
+    _lastError = e;
+    _lastErrno = err;
+
+    errorMessage = "Encoder: ";
+    errorMessage += buttonErrorMessage(e);
+    if (e == ButtonError::ChipOpen) errorMessage += " " + _chipPath;
+    else if (e == ButtonError::LineRequest || e == ButtonError::KernelDebounce) {
+        errorMessage += " for lines " + std::to_string(_pinA) + "/" + std::to_string(_pinB);
+    }
+    if (err) {
+        errorMessage += ": ";
+        errorMessage += std::strerror(err);
+    } else {
+        errorMessage += ".";
+    }
+    return false;
+}
+
+bool Encoder::_request(uint32_t debounce_us)
+{
+    _chip = ButtonChipCache::acquire(_chipPath);
+    int err = 0;
+    const int chipfd = ButtonChipCache::fd(_chip, err);
+    if (chipfd < 0) {
+        clean();
+        return _fail(ButtonError::ChipOpen, err);
+    }
+
+    gpio_v2_line_request req{};
+    req.offsets[0] = _pinA;
+    req.offsets[1] = _pinB;
+    req.num_lines = 2;
+    req.event_buffer_size = EVENT_BATCH * 4;   // headroom for bursts between reads
+    std::strncpy(req.consumer, "Encoder", sizeof(req.consumer) - 1);
+
+    uint64_t flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+    switch (_bias) {
+        case 1:  flags |= GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN; break;
+        case 2:  flags |= GPIO_V2_LINE_FLAG_BIAS_PULL_UP;   break;
+        default: flags |= GPIO_V2_LINE_FLAG_BIAS_DISABLED;  break;
+    }
+    req.config.flags = flags;
+
+    if (debounce_us > 0) {
+        req.config.num_attrs = 1;
+        req.config.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_DEBOUNCE;
+        req.config.attrs[0].attr.debounce_period_us = debounce_us;
+        req.config.attrs[0].mask = 3;   // both lines of the request
+    }
+
+    if (::ioctl(chipfd, GPIO_V2_GET_LINE_IOCTL, &req) < 0) {
+        err = errno;
+        clean();
+        return _fail(debounce_us > 0 ? ButtonError::KernelDebounce : ButtonError::LineRequest, err);
+    }
+    _fd = req.fd;
+
+    // Non-blocking fd lets processPendingEvents() drain without a final blocking read
+    const int fl = ::fcntl(_fd, F_GETFL);
+    if (fl < 0 || ::fcntl(_fd, F_SETFL, fl | O_NONBLOCK) < 0) {
+        err = errno;
+        clean();
+        return _fail(ButtonError::NonBlock, err);
+    }
+
+    if (!_readState()) {
+        err = errno;
+        clean();
+        return _fail(ButtonError::LineRequest, err);
+    }
+    _seqno = 0;
+    _velHead = 0;
+    _velFill = 0;
+    return true;
+}
+
+bool Encoder::_readState(void)
+{
+    gpio_v2_line_values vals{};
+    vals.mask = 3;
+    if (::ioctl(_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &vals) < 0) return false;
+
+    _state = static_cast<uint8_t>(vals.bits & 3);
+    return true;
+}
+
+void Encoder::_decode(const void* raw, size_t n)
+{
+    const gpio_v2_line_event* evs = static_cast<const gpio_v2_line_event*>(raw);
+
+    int64_t cnt = _count.load(std::memory_order_relaxed);
+    const int64_t start = cnt;
+    uint8_t state = _state;
+    uint64_t errors = 0;
+    int64_t last = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        const gpio_v2_line_event& ev = evs[i];
+
+        // The request numbers its events 1, 2, 3 ...: a gap is a FIFO overflow
+        if (_seqno && ev.seqno != _seqno + 1 && ev.seqno > _seqno) {
+            _overflows.store(_overflows.load(std::memory_order_relaxed) + (ev.seqno - _seqno - 1),
+                             std::memory_order_relaxed);
+        }
+        _seqno = ev.seqno;
+
+        const uint8_t bit = (ev.offset == _pinA) ? 1 : 2;
+        const uint8_t next = static_cast<uint8_t>((ev.id == GPIO_V2_LINE_EVENT_RISING_EDGE) ? (state | bit) : (state & ~bit));
+        if (next == state) {
+            ++errors;           // same level twice: the opposite edge was lost
+            continue;
+        }
+
+        cnt += QUADRATURE_LUT[(state << 2) | next];
+        state = next;
+
+        // Step history for velocity(); a pause restarts it
+        const int64_t ts = static_cast<int64_t>(ev.timestamp_ns);
+        const unsigned int prev = (_velHead + VEL_STEPS - 1) % VEL_STEPS;
+        if (_velFill && ts - _velTs[prev] > IDLE_NS) _velFill = 0;
+        _velTs[_velHead] = ts;
+        _velCount[_velHead] = cnt;
+        _velHead = (_velHead + 1) % VEL_STEPS;
+        if (_velFill < VEL_STEPS) ++_velFill;
+        last = ts;
+    }
+    _state = state;
+
+    if (errors) _errors.store(_errors.load(std::memory_order_relaxed) + errors, std::memory_order_relaxed);
+    if (last == 0) return;
+
+    double v = 0.0;
+    if (_velFill > 1) {
+        const unsigned int newest = (_velHead + VEL_STEPS - 1) % VEL_STEPS;
+        const unsigned int oldest = (_velHead + VEL_STEPS - _velFill) % VEL_STEPS;
+        const int64_t dt = _velTs[newest] - _velTs[oldest];
+        if (dt > 0) v = static_cast<double>(_velCount[newest] - _velCount[oldest]) * 1e9 / static_cast<double>(dt);
+    }
+
+    // One store per batch keeps readers off the cache line while edges stream in
+    _count.store(cnt, std::memory_order_relaxed);
+    _velocity.store(v, std::memory_order_relaxed);
+    _lastTs.store(last, std::memory_order_relaxed);
+
+    if (_cb && cnt != start) _cb(_user, cnt, static_cast<int32_t>(cnt - start));
+}
+
+void Encoder::_loop(void)
+{
+    Button::_enterThread(_threadOpts);
+
+    pollfd fds[2];
+    fds[0].fd = _fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = _wakeFd;
+    fds[1].events = POLLIN;
+
+    while (_running.load()) {
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+        const int n = ::poll(fds, 2, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[0].revents & POLLIN) processPendingEvents();
+        if (fds[0].revents & (POLLHUP | POLLERR | POLLNVAL)) {
+            // Chip unplugged: stop polling the lines, keep waiting for stop()
+            _gone.store((fds[0].revents & POLLHUP) ? ENODEV : EIO, std::memory_order_release);
+            fds[0].fd = -1;
+        }
+        if (fds[1].revents & POLLIN) {
+            uint64_t cnt;
+            while (::read(_wakeFd, &cnt, sizeof(cnt)) > 0) {}
+        }
+    }
+}
@@ -0,0 +1,260 @@
+/**
+ * @file Encoder.h
+ * @brief Quadrature (rotary) encoder decoded from the kernel edge events of two lines.
+ *
+ * Both channels are requested together with one GPIO uAPI v2 line request,
+ * so their edges arrive in one kernel FIFO in the order they happened, each
+ * tagged with its line and a kernel timestamp. Batches of events are decoded
+ * with a 16-entry lookup table on the event thread and published as relaxed
+ * atomics: position(), count() and velocity() never lock or enter the kernel.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Include libraries:
+
+#include "Button.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+struct ButtonChip;
+
+// #################################################################################
+// Encoder class:
+
+/**
+ * @brief Encoder movement callback.
+ *
+ * @param user  Context pointer given to Encoder::setCallback().
+ * @param count Quadrature count after the batch (see Encoder::count()).
+ * @param delta Net change of the count in the batch (never 0).
+ */
+using EncoderCallback = void(*)(void* user, int64_t count, int32_t delta);
+
+/**
+ * @class Encoder
+ * @brief A/B quadrature decoder on two lines of one chip.
+ *
+ * Usage:
+ *  - begin() requests both lines and starts the event thread,
+ *    or beginEvents() + eventFd() + processPendingEvents() from your own loop.
+ *  - Read position()/velocity() from any thread.
+ *
+ * Every valid A/B transition is one count (four per full quadrature cycle).
+ * Contact bounce on one channel cancels out in the state machine; an event
+ * that does not change the decoded state means edges were lost and is
+ * counted in errors(). Kernel FIFO overflows are detected from the event
+ * sequence numbers and counted in overflows(); the counts they carried are
+ * lost, but each following event re-synchronizes the level of its line.
+ *
+ * @note Swap @p pinA and @p pinB to reverse the direction.
+ */
+class Encoder
+{
+    public:
+
+        /**
+         * @brief Events read from the kernel per read() call.
+         */
+        static constexpr unsigned int EVENT_BATCH = 64;
+
+        /**
+         * @brief Stores last error message (set if an operation fails).
+         */
+        std::string errorMessage;
+
+        /**
+         * @brief Constructor.
+         *
+         * @param chipPath Path to GPIO chip (e.g. "/dev/gpiochip0").
+         * @param pinA     Line offset of channel A.
+         * @param pinB     Line offset of channel B.
+         * @param bias     Bias: 0=off, 1=pull-down, 2=pull-up (default).
+         */
+        Encoder(const std::string& chipPath, unsigned int pinA, unsigned int pinB, uint8_t bias = 2);
+
+        Encoder(const Encoder&) = delete;
+        Encoder& operator=(const Encoder&) = delete;
+
+        /**
+         * @brief Destructor. Calls @ref clean().
+         */
+        ~Encoder();
+
+        /**
+         * @brief Counts per detent used by position() (default 4, one full cycle).
+         */
+        void setStepsPerDetent(unsigned int steps);
+
+        /**
+         * @brief Call @p cb once per decoded batch with a non-zero net movement.
+         *
+         * Runs on the thread that decodes (event thread or processPendingEvents()).
+         * Must be set before begin().
+         */
+        void setCallback(EncoderCallback cb, void* user = nullptr);
+
+        /**
+         * @brief Set scheduling options for the event thread (applied by the next begin()).
+         */
+        void setThreadOptions(const ButtonThreadOptions& opts);
+
+        /**
+         * @brief Request both lines for edge events and start the event thread.
+         *
+         * @param debounce_us Kernel debounce period per line (0 = none). Needs kernel
+         *                    debounce support; mechanical encoders usually work without.
+         * @return true on success, false on error (see errorMessage).
+         */
+        bool begin(uint32_t debounce_us = 0);
+
+        /**
+         * @brief Request both lines for edge events without starting a thread.
+         *
+         * Wait for POLLIN/EPOLLIN on eventFd() and call processPendingEvents().
+         *
+         * @param debounce_us Kernel debounce period per line (0 = none).
+         * @return true on success, false on error (see errorMessage).
+         */
+        bool beginEvents(uint32_t debounce_us = 0);
+
+        /**
+         * @brief Line event fd of the request (-1 if not begun).
+         */
+        int eventFd(void) const;
+
+        /**
+         * @brief Drain and decode every queued kernel event (non-blocking).
+         * @return Number of kernel events decoded.
+         */
+        size_t processPendingEvents(void);
+
+        /**
+         * @brief Stop the event thread (no-op if not running). The request stays.
+         */
+        void stop(void);
+
+        /**
+         * @brief Stop the thread and release both lines.
+         */
+        void clean(void);
+
+        /**
+         * @brief Quadrature count (4 per cycle, positive = A leads B). Any thread.
+         */
+        int64_t count(void) const;
+
+        /**
+         * @brief count() divided by the steps per detent (truncated toward zero). Any thread.
+         */
+        int64_t position(void) const;
+
+        /**
+         * @brief Counts per second over the last steps (0 once idle for 100 ms). Any thread.
+         */
+        double velocity(void) const;
+
+        /**
+         * @brief Set count() to @p count (e.g. after homing). Only while no thread decodes.
+         */
+        void reset(int64_t count = 0);
+
+        /**
+         * @brief Events that left the decoded state unchanged (lost edges).
+         */
+        uint64_t errors(void) const;
+
+        /**
+         * @brief Events dropped by the kernel FIFO (sequence number gaps).
+         */
+        uint64_t overflows(void) const;
+
+        /**
+         * @brief Code of the last begin call (ButtonError::None after success).
+         *
+         * ButtonError::LineGone once the event thread saw the line fd hang up
+         * or fail (chip unplugged); the thread then stops polling it.
+         */
+        ButtonError lastError(void) const;
+
+        /**
+         * @brief errno of the system call behind lastError() (0 if none).
+         */
+        int lastErrno(void) const;
+
+    private:
+
+        /**
+         * @brief Steps kept for velocity().
+         */
+        static constexpr unsigned int VEL_STEPS = 8;
+
+        /**
+         * @brief Velocity reads 0 after this long without a step.
+         */
+        static constexpr int64_t IDLE_NS = 100000000LL;
+
+        std::string     _chipPath;                  ///< GPIO chip path
+        unsigned int    _pinA;                      ///< Channel A line offset
+        unsigned int    _pinB;                      ///< Channel B line offset
+        uint8_t         _bias;                      ///< Bias: 0=off, 1=pull-down, 2=pull-up
+        unsigned int    _steps = 4;                 ///< Counts per detent
+
+        ButtonChip*     _chip = nullptr;            ///< Shared chip of the request (ButtonChipCache)
+        int             _fd = -1;                   ///< Line request fd (both lines)
+        int             _wakeFd = -1;               ///< eventfd waking the thread on stop()
+        std::thread     _thread;                    ///< Event thread
+        std::atomic<bool> _running{false};          ///< Thread run flag
+        ButtonThreadOptions _threadOpts;            ///< Options applied to _thread
+        EncoderCallback _cb = nullptr;              ///< Movement callback
+        void*           _user = nullptr;            ///< Callback context
+
+        ButtonError     _lastError = ButtonError::None;     ///< Code of the last begin call
+        int             _lastErrno = 0;             ///< errno behind _lastError
+        std::atomic<int> _gone{0};                  ///< errno of a hung-up/failed line fd, set by the thread (0 = healthy)
+
+        // Decoder state (decoding thread only)
+        uint8_t         _state = 0;                 ///< Current A/B state (bit 0 = A, bit 1 = B)
+        uint64_t        _seqno = 0;                 ///< Last kernel sequence number
+        int64_t         _velTs[VEL_STEPS] = {};     ///< Timestamps of the last steps
+        int64_t         _velCount[VEL_STEPS] = {};  ///< Counts after the last steps
+        unsigned int    _velHead = 0;               ///< Next _velTs/_velCount slot
+        unsigned int    _velFill = 0;               ///< Valid slots
+
+        // Published results (one writer, any readers)
+        std::atomic<int64_t>  _count{0};            ///< Quadrature count
+        std::atomic<double>   _velocity{0.0};       ///< Counts per second at _lastTs
+        std::atomic<int64_t>  _lastTs{0};           ///< Timestamp of the last step
+        std::atomic<uint64_t> _errors{0};           ///< Lost-edge events
+        std::atomic<uint64_t> _overflows{0};        ///< Kernel FIFO drops
+
+        /**
+         * @brief Record the failure code and errno, and format errorMessage.
+         */
+        bool _fail(ButtonError e, int err = 0);
+
+        /**
+         * @brief Issue the two-line request and read the initial state.
+         */
+        bool _request(uint32_t debounce_us);
+
+        /**
+         * @brief Read both line levels into _state.
+         */
+        bool _readState(void);
+
+        /**
+         * @brief Decode @p n raw kernel events and publish the results.
+         */
+        void _decode(const void* raw, size_t n);
+
+        /**
+         * @brief Event thread body.
+         */
+        void _loop(void);
+};
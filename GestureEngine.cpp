@@ -0,0 +1,142 @@
+// #######################################################################
+// Include Libraries:
+
+#include "GestureEngine.h"
+
+// #######################################################################
+// GestureEngine class:
+
+GestureEngine::GestureEngine(uint32_t tick_us)
+: _wheel(tick_us)
+{}
+
+void GestureEngine::setCallback(GestureCallback cb, void* user)
+{
+    _cb = cb;
+    _user = user;
+}
+
+unsigned int GestureEngine::add(void)
+{
+    return add(Config{});
+}
+
+unsigned int GestureEngine::add(const Config& cfg)
+{
+    const unsigned int id = static_cast<unsigned int>(_inputs.size());
+    _inputs.emplace_back();
+    Input& in = _inputs.back();
+    in.engine = this;
+    in.id = id;
+    in.cfg = cfg;
+    in.timer.fn = &GestureEngine::_onTimer;
+    in.timer.ctx = &in;
+    return id;
+}
+
+ButtonDelegate GestureEngine::input(unsigned int id)
+{
+    return [this, id](bool rising, uint64_t ts_ns) { onEdge(id, rising, ts_ns); };
+}
+
+void GestureEngine::onEdge(unsigned int id, bool rising, long sec, long nsec)
+{
+    onEdge(id, rising, static_cast<uint64_t>(sec) * 1000000000ULL + static_cast<uint64_t>(nsec));
+}
+
+void GestureEngine::onEdge(unsigned int id, bool rising, uint64_t ts_ns)
+{
+    if (id >= _inputs.size()) return;
+
+    Input& in = _inputs[id];
+    const int64_t ns = static_cast<int64_t>(ts_ns);
+    const int64_t long_ns = static_cast<int64_t>(in.cfg.long_ms) * 1000000LL;
+
+    if (rising) {
+        switch (in.state) {
+            case State::Idle:
+                in.state = State::Down;
+                _wheel.schedule(in.timer, ns + long_ns);
+                break;
+            case State::WaitSecond:
+                in.state = State::Down2;
+                _wheel.schedule(in.timer, ns + long_ns);
+                break;
+            default:
+                break;      // duplicate press edge
+        }
+        return;
+    }
+
+    switch (in.state) {
+        case State::Down:
+            if (in.cfg.double_gap_ms > 0) {
+                in.state = State::WaitSecond;
+                _wheel.schedule(in.timer, ns + static_cast<int64_t>(in.cfg.double_gap_ms) * 1000000LL);
+            }
+            else {
+                _wheel.cancel(in.timer);
+                in.state = State::Idle;
+                _emit(in, Gesture::Click);
+            }
+            break;
+        case State::Down2:
+            _wheel.cancel(in.timer);
+            in.state = State::Idle;
+            _emit(in, Gesture::DoubleClick);
+            break;
+        case State::Held:
+            _wheel.cancel(in.timer);
+            in.state = State::Idle;
+            break;
+        default:
+            break;      // duplicate release edge
+    }
+}
+
+TimerWheel& GestureEngine::timers(void)
+{
+    return _wheel;
+}
+
+void GestureEngine::tick(void)
+{
+    _wheel.advance(TimerWheel::now());
+}
+
+void GestureEngine::_emit(Input& in, Gesture g)
+{
+    if (_cb) _cb(_user, in.id, g);
+}
+
+void GestureEngine::_onTimer(void* ctx)
+{
+    Input& in = *static_cast<Input*>(ctx);
+    GestureEngine& e = *in.engine;
+    const int64_t deadline = in.timer.deadline_ns;
+
+    switch (in.state) {
+        case State::WaitSecond:
+            // Gap expired without a second press
+            in.state = State::Idle;
+            e._emit(in, Gesture::Click);
+            break;
+        case State::Down2:
+            // Second press turned into a hold: report the first click, then the long press
+            e._emit(in, Gesture::Click);
+            // fall through
+        case State::Down:
+            in.state = State::Held;
+            e._emit(in, Gesture::LongPress);
+            if (in.cfg.repeat_ms > 0) {
+                e._wheel.schedule(in.timer, deadline + static_cast<int64_t>(in.cfg.repeat_ms) * 1000000LL);
+            }
+            break;
+        case State::Held:
+            e._emit(in, Gesture::Repeat);
+            e._wheel.schedule(in.timer, deadline + static_cast<int64_t>(in.cfg.repeat_ms) * 1000000LL);
+            break;
+        default:
+            break;
+    }
+}
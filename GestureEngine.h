@@ -0,0 +1,156 @@
+/**
+ * @file GestureEngine.h
+ * @brief Click / double-click / long-press / repeat detection from timestamped edges.
+ *
+ * A GestureEngine turns the press/release edges of many buttons into gesture
+ * events. Edge timing comes from the kernel `ts_ns` timestamps passed to
+ * the Button callback (CLOCK_MONOTONIC, the Button default event clock),
+ * and all pending deadlines (long-press, repeat, double-click gap) of all
+ * buttons live in one shared TimerWheel. Attached to
+ * a ButtonGroup, both edges and timers are served by the group's single
+ * thread: no timer thread per button.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Include libraries:
+
+#include "Button.h"
+#include "TimerWheel.h"
+#include <deque>
+
+// #################################################################################
+
+/**
+ * @brief Gesture kinds emitted by GestureEngine.
+ */
+enum class Gesture : uint8_t
+{
+    Click,          ///< Short press and release (no second click within the gap)
+    DoubleClick,    ///< Two short presses within the double-click gap
+    LongPress,      ///< Held for the long-press threshold
+    Repeat          ///< Still held: emitted every repeat period after LongPress
+};
+
+/**
+ * @brief Gesture callback.
+ *
+ * @param user    Context pointer given to GestureEngine::setCallback().
+ * @param id      Input id returned by GestureEngine::add().
+ * @param gesture Detected gesture.
+ */
+using GestureCallback = void(*)(void* user, unsigned int id, Gesture gesture);
+
+// #################################################################################
+// GestureEngine class:
+
+/**
+ * @class GestureEngine
+ * @brief Per-button gesture state machines sharing one timer wheel.
+ *
+ * Usage with a ButtonGroup:
+ * @code
+ *   GestureEngine gestures;
+ *   gestures.setCallback(onGesture, this);
+ *   unsigned id = gestures.add();
+ *   group.add(btn, AUXI::Edge::Both, 5000, gestures.input(id));
+ *   group.setTimerWheel(&gestures.timers());
+ *   group.begin();
+ * @endcode
+ *
+ * Rising edges are treated as press and falling edges as release (the event
+ * path already applies polarity).
+ *
+ * @note Not thread-safe: all inputs and the timer wheel of one engine must be
+ *       driven from the same thread (e.g. one ButtonGroup). Add all inputs
+ *       before events start flowing.
+ */
+class GestureEngine
+{
+    public:
+
+        /**
+         * @brief Gesture timing thresholds of one input.
+         */
+        struct Config
+        {
+            uint32_t long_ms = 800;         ///< Hold time for LongPress
+            uint32_t repeat_ms = 0;         ///< Repeat period after LongPress (0 = no Repeat)
+            uint32_t double_gap_ms = 300;   ///< Max release-to-press gap for DoubleClick (0 = no DoubleClick)
+        };
+
+        /**
+         * @brief Construct an engine.
+         * @param tick_us Timer wheel granularity in microseconds (default 1000).
+         */
+        explicit GestureEngine(uint32_t tick_us = 1000);
+
+        GestureEngine(const GestureEngine&) = delete;
+        GestureEngine& operator=(const GestureEngine&) = delete;
+
+        /**
+         * @brief Set the gesture callback (invoked from the driving thread).
+         */
+        void setCallback(GestureCallback cb, void* user = nullptr);
+
+        /**
+         * @brief Add an input with default thresholds.
+         * @return Input id used by input() and in callbacks.
+         */
+        unsigned int add(void);
+
+        /**
+         * @brief Add an input with custom thresholds.
+         * @return Input id used by input() and in callbacks.
+         */
+        unsigned int add(const Config& cfg);
+
+        /**
+         * @brief Edge callback feeding input @p id, for Button::beginInterrupt() or ButtonGroup::add().
+         */
+        ButtonDelegate input(unsigned int id);
+
+        /**
+         * @brief Feed one edge manually (press = rising).
+         */
+        void onEdge(unsigned int id, bool rising, uint64_t ts_ns);
+
+        /**
+         * @brief Legacy form of onEdge() taking a split timestamp.
+         */
+        void onEdge(unsigned int id, bool rising, long sec, long nsec);
+
+        /**
+         * @brief Shared timer wheel (give it to ButtonGroup::setTimerWheel()).
+         */
+        TimerWheel& timers(void);
+
+        /**
+         * @brief Fire due gesture timers when not driven by a ButtonGroup.
+         */
+        void tick(void);
+
+    private:
+
+        enum class State : uint8_t { Idle, Down, WaitSecond, Down2, Held };
+
+        struct Input
+        {
+            GestureEngine*      engine;                 ///< Owning engine
+            unsigned int        id;                     ///< Input id
+            Config              cfg;                    ///< Thresholds
+            State               state = State::Idle;    ///< Gesture state
+            TimerWheel::Timer   timer;                  ///< Long-press / repeat / gap timer
+        };
+
+        TimerWheel          _wheel;                 ///< Shared timer wheel
+        std::deque<Input>   _inputs;                ///< Inputs (deque keeps timer nodes stable)
+        GestureCallback     _cb = nullptr;          ///< Gesture callback
+        void*               _user = nullptr;        ///< Gesture callback context
+
+        void _emit(Input& in, Gesture g);
+        static void _onTimer(void* ctx);
+};
@@ -0,0 +1,79 @@
+// #######################################################################
+// Include Libraries:
+
+#include "LatencyHistogram.h"
+
+// #######################################################################
+// LatencyHistogram class:
+
+void LatencyHistogram::record(int64_t ns) noexcept
+{
+    const uint64_t v = ns > 0 ? static_cast<uint64_t>(ns) : 0;
+
+    _buckets[_index(v)].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t m = _max.load(std::memory_order_relaxed);
+    while (v > m && !_max.compare_exchange_weak(m, v, std::memory_order_relaxed)) {}
+}
+
+uint64_t LatencyHistogram::percentile(double q) const noexcept
+{
+    const uint64_t total = _count.load(std::memory_order_relaxed);
+    if (total == 0) return 0;
+
+    if (q < 0.0) q = 0.0;
+    if (q > 1.0) q = 1.0;
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total) + 0.5);
+    if (rank == 0) rank = 1;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += _buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            const uint64_t up = _upper(i);
+            const uint64_t m = max();
+            return up < m ? up : m;     // never report above the exact maximum
+        }
+    }
+    return max();
+}
+
+uint64_t LatencyHistogram::max(void) const noexcept
+{
+    return _max.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::count(void) const noexcept
+{
+    return _count.load(std::memory_order_relaxed);
+}
+
+void LatencyHistogram::reset(void) noexcept
+{
+    for (auto& b : _buckets) b.store(0, std::memory_order_relaxed);
+    _count.store(0, std::memory_order_relaxed);
+    _max.store(0, std::memory_order_relaxed);
+}
+
+size_t LatencyHistogram::_index(uint64_t v) noexcept
+{
+    constexpr uint64_t sub = 1ULL << SUB_BITS;
+    if (v < sub) return static_cast<size_t>(v);
+
+    unsigned int e = 63u - static_cast<unsigned int>(__builtin_clzll(v));
+    if (e > MAX_EXP) return BUCKETS - 1;
+
+    const uint64_t mant = (v >> (e - SUB_BITS)) & (sub - 1);
+    return static_cast<size_t>(((e - SUB_BITS + 1) << SUB_BITS) + mant);
+}
+
+uint64_t LatencyHistogram::_upper(size_t idx) noexcept
+{
+    constexpr uint64_t sub = 1ULL << SUB_BITS;
+    if (idx < sub) return idx;
+
+    const unsigned int e = static_cast<unsigned int>(idx >> SUB_BITS) + SUB_BITS - 1;
+    const uint64_t mant = idx & (sub - 1);
+    return ((sub + mant + 1) << (e - SUB_BITS)) - 1;
+}
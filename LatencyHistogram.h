@@ -0,0 +1,95 @@
+/**
+ * @file LatencyHistogram.h
+ * @brief Lock-free fixed-bucket (HDR-style log-linear) latency histogram.
+ *
+ * Values are nanoseconds. Each power-of-two range is split into 16 linear
+ * sub-buckets, which bounds the relative error of any reported percentile to
+ * about 6%. Recording is a couple of relaxed atomic increments, with no locks
+ * and no allocation, so it can run on the event thread for every edge.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Include libraries:
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// #################################################################################
+// LatencyHistogram class:
+
+/**
+ * @class LatencyHistogram
+ * @brief Lock-free log-linear histogram of nanosecond durations.
+ *
+ * record() may be called from any thread (typically one event thread);
+ * percentile accessors may be called concurrently from any other thread and
+ * return a consistent-enough snapshot for monitoring.
+ */
+class LatencyHistogram
+{
+    public:
+
+        /**
+         * @brief Linear sub-buckets per power of two (as a bit count).
+         */
+        static constexpr unsigned int SUB_BITS = 4;
+
+        /**
+         * @brief Largest power of two tracked; larger values land in the last bucket.
+         */
+        static constexpr unsigned int MAX_EXP = 40;     // ~18 minutes in ns
+
+        /**
+         * @brief Total number of buckets.
+         */
+        static constexpr size_t BUCKETS = (MAX_EXP - SUB_BITS + 2) << SUB_BITS;
+
+        LatencyHistogram() = default;
+
+        LatencyHistogram(const LatencyHistogram&) = delete;
+        LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+        /**
+         * @brief Record one duration in nanoseconds (negative values count as 0).
+         */
+        void record(int64_t ns) noexcept;
+
+        /**
+         * @brief Value at quantile @p q (0..1), as the upper bound of its bucket.
+         * @return Nanoseconds, or 0 if nothing has been recorded.
+         */
+        uint64_t percentile(double q) const noexcept;
+
+        uint64_t p50(void) const noexcept  { return percentile(0.50); }     ///< Median
+        uint64_t p99(void) const noexcept  { return percentile(0.99); }     ///< 99th percentile
+        uint64_t p999(void) const noexcept { return percentile(0.999); }    ///< 99.9th percentile
+
+        /**
+         * @brief Exact maximum recorded value in nanoseconds.
+         */
+        uint64_t max(void) const noexcept;
+
+        /**
+         * @brief Number of recorded values.
+         */
+        uint64_t count(void) const noexcept;
+
+        /**
+         * @brief Clear all buckets (not atomic with respect to concurrent record()).
+         */
+        void reset(void) noexcept;
+
+    private:
+
+        std::atomic<uint64_t> _buckets[BUCKETS] = {};   ///< Bucket counters
+        std::atomic<uint64_t> _count{0};                ///< Total values
+        std::atomic<uint64_t> _max{0};                  ///< Exact maximum
+
+        static size_t _index(uint64_t v) noexcept;
+        static uint64_t _upper(size_t idx) noexcept;
+};
@@ -0,0 +1,125 @@
+/**
+ * @file SpscRing.h
+ * @brief Lock-free single-producer/single-consumer ring buffer.
+ *
+ * Fixed-capacity ring used to hand edge events from an event thread to an
+ * application thread. Storage is allocated once in the constructor; push()
+ * and pop() take no locks and never allocate. When the ring is full the new
+ * element is dropped and an overflow counter is incremented, so a producer
+ * is never blocked by a slow consumer.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Include libraries:
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// #################################################################################
+// SpscRing class:
+
+/**
+ * @class SpscRing
+ * @brief Bounded wait-free SPSC queue of trivially copyable elements.
+ *
+ * Exactly one thread may call push() and exactly one (other) thread may call
+ * pop(). size() and overflows() may be called from any thread.
+ *
+ * @tparam T Element type (should be trivially copyable).
+ */
+template <typename T>
+class SpscRing
+{
+    public:
+
+        /**
+         * @brief Allocate a ring for at least @p capacity elements.
+         * @param capacity Requested capacity, rounded up to a power of two (min 2).
+         */
+        explicit SpscRing(size_t capacity)
+        {
+            size_t cap = 2;
+            while (cap < capacity) cap <<= 1;
+            _buf.reset(new T[cap]);
+            _mask = cap - 1;
+        }
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        /**
+         * @brief Append one element (producer side).
+         * @return true if stored, false if the ring was full (overflow counted).
+         */
+        bool push(const T& v) noexcept
+        {
+            const size_t head = _head.load(std::memory_order_relaxed);
+            if (head - _tailCache > _mask) {
+                _tailCache = _tail.load(std::memory_order_acquire);
+                if (head - _tailCache > _mask) {
+                    _overflows.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+            }
+            _buf[head & _mask] = v;
+            _head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Remove up to @p max elements into @p out (consumer side).
+         * @return Number of elements copied.
+         */
+        size_t pop(T* out, size_t max) noexcept
+        {
+            const size_t tail = _tail.load(std::memory_order_relaxed);
+            const size_t head = _head.load(std::memory_order_acquire);
+            size_t n = head - tail;
+            if (n > max) n = max;
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = _buf[(tail + i) & _mask];
+            }
+            _tail.store(tail + n, std::memory_order_release);
+            return n;
+        }
+
+        /**
+         * @brief Approximate number of queued elements.
+         */
+        size_t size(void) const noexcept
+        {
+            return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Usable capacity (power of two).
+         */
+        size_t capacity(void) const noexcept
+        {
+            return _mask + 1;
+        }
+
+        /**
+         * @brief Number of elements dropped because the ring was full.
+         */
+        uint64_t overflows(void) const noexcept
+        {
+            return _overflows.load(std::memory_order_relaxed);
+        }
+
+    private:
+
+        std::unique_ptr<T[]>    _buf;                   ///< Element storage
+        size_t                  _mask = 0;              ///< capacity - 1
+
+        alignas(64) std::atomic<size_t>   _head{0};     ///< Next write index (producer-owned)
+        size_t                            _tailCache = 0; ///< Producer's last view of _tail
+        alignas(64) std::atomic<size_t>   _tail{0};     ///< Next read index (consumer-owned)
+        alignas(64) std::atomic<uint64_t> _overflows{0}; ///< Dropped-element counter
+};
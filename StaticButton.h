@@ -0,0 +1,307 @@
+/**
+ * @file StaticButton.h
+ * @brief Push-button whose chip, line, polarity, bias, edge and debounce are template parameters.
+ *
+ * Button validates and branches on small integer codes at runtime (mode,
+ * bias, edge selector, debounce window). StaticButton moves all of that to
+ * compile time: invalid configurations do not compile, the GPIO uAPI v2
+ * request flags are a constant, and the event path is specialized with
+ * `if constexpr` (no debounce code for DebounceUs == 0, no level read for
+ * both-edge requests, no runtime edge or polarity checks).
+ *
+ * It has no thread of its own: register eventFd() in an epoll/io_uring loop
+ * (or poll() it) and call processPendingEvents() when it is readable.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Include libraries:
+
+#include "Button.h"
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+// #################################################################################
+// Configuration types:
+
+/**
+ * @brief Line polarity (same codes as the Button `mode` argument).
+ */
+enum class ButtonPolarity : uint8_t
+{
+    ActiveLow  = 0,     ///< raw=0 → pressed
+    ActiveHigh = 1      ///< raw=1 → pressed
+};
+
+/**
+ * @brief Line bias (same codes as the Button `bias` argument).
+ */
+enum class ButtonBias : uint8_t
+{
+    Off      = 0,       ///< Bias disabled
+    PullDown = 1,       ///< Pull-down
+    PullUp   = 2        ///< Pull-up
+};
+
+/**
+ * @brief `/dev/gpiochip<n>` as a compile-time string.
+ */
+constexpr std::array<char, 24> gpiochipPath(unsigned int n)
+{
+    std::array<char, 24> s{};
+    const char prefix[] = "/dev/gpiochip";
+    size_t len = 0;
+    for (; prefix[len]; ++len) s[len] = prefix[len];
+
+    char digits[10] = {};
+    size_t d = 0;
+    do { digits[d++] = static_cast<char>('0' + n % 10); n /= 10; } while (n);
+    while (d) s[len++] = digits[--d];
+    return s;
+}
+
+// #################################################################################
+// StaticButton class:
+
+/**
+ * @class StaticButton
+ * @brief Compile-time configured push-button on `/dev/gpiochip<Chip>` line @p Pin.
+ *
+ * Example:
+ * @code
+ * using StartKey = StaticButton<0, 17, ButtonPolarity::ActiveLow, ButtonBias::PullUp,
+ *                               AUXI::Edge::Both, 5000>;
+ * StartKey key;
+ * key.begin(on_edge);
+ * // epoll_ctl(epfd, EPOLL_CTL_ADD, key.eventFd(), ...); then key.processPendingEvents()
+ * @endcode
+ *
+ * Uses the GPIO character device uAPI v2 directly (Linux ≥ 5.10).
+ *
+ * @tparam Chip       gpiochip number.
+ * @tparam Pin        Line offset on the chip.
+ * @tparam Polarity   ButtonPolarity::ActiveHigh or ActiveLow.
+ * @tparam Bias       ButtonBias::Off, PullDown or PullUp.
+ * @tparam Edge       AUXI::Edge::Both, Rising or Falling (filtered by the kernel).
+ * @tparam DebounceUs Software debounce window in µs (0 = none).
+ */
+template <unsigned int Chip, unsigned int Pin,
+          ButtonPolarity Polarity = ButtonPolarity::ActiveHigh,
+          ButtonBias Bias = ButtonBias::Off,
+          AUXI::Edge Edge = AUXI::Edge::Both,
+          uint32_t DebounceUs = 5000>
+class StaticButton
+{
+    static_assert(Polarity == ButtonPolarity::ActiveLow || Polarity == ButtonPolarity::ActiveHigh,
+                  "StaticButton: polarity must be ActiveLow or ActiveHigh");
+    static_assert(Bias == ButtonBias::Off || Bias == ButtonBias::PullDown || Bias == ButtonBias::PullUp,
+                  "StaticButton: bias must be Off, PullDown or PullUp");
+    static_assert(Edge == AUXI::Edge::Both || Edge == AUXI::Edge::Rising || Edge == AUXI::Edge::Falling,
+                  "StaticButton: edge must be Both, Rising or Falling");
+    static_assert(DebounceUs <= 10000000U, "StaticButton: debounce window above 10 s is not sensible");
+
+    public:
+
+        static constexpr unsigned int chip = Chip;     ///< gpiochip number
+        static constexpr unsigned int pin = Pin;       ///< Line offset
+
+        /**
+         * @brief Stores last error message (set if an operation fails).
+         */
+        std::string errorMessage;
+
+        StaticButton() = default;
+
+        StaticButton(const StaticButton&) = delete;
+        StaticButton& operator=(const StaticButton&) = delete;
+
+        /**
+         * @brief Destructor. Calls @ref clean().
+         */
+        ~StaticButton() { clean(); }
+
+        /**
+         * @brief Request the line for edge events (no thread is started).
+         * @param cb Callback for accepted edges (must not be empty).
+         * @return true on success, false on error (see errorMessage).
+         */
+        bool begin(ButtonDelegate cb);
+
+        /**
+         * @brief Non-blocking line event fd for an external loop (-1 before begin()).
+         */
+        int eventFd(void) const { return _fd; }
+
+        /**
+         * @brief Drain, debounce and dispatch all queued edges without blocking.
+         * @return Number of kernel edges read (before debounce).
+         */
+        size_t processPendingEvents(void);
+
+        /**
+         * @brief Cached LOGICAL state (one atomic load).
+         */
+        bool get(void) const { return _state.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Read the LOGICAL state from the line (one ioctl) and refresh the cache.
+         */
+        bool read(void);
+
+        /**
+         * @brief Release the line (no-op if not requested).
+         */
+        void clean(void);
+
+    private:
+
+        /**
+         * @brief Line request flags, fixed at compile time.
+         */
+        static constexpr uint64_t FLAGS =
+            GPIO_V2_LINE_FLAG_INPUT |
+            (Edge == AUXI::Edge::Rising  ? GPIO_V2_LINE_FLAG_EDGE_RISING :
+             Edge == AUXI::Edge::Falling ? GPIO_V2_LINE_FLAG_EDGE_FALLING :
+                                           GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING) |
+            (Polarity == ButtonPolarity::ActiveLow ? GPIO_V2_LINE_FLAG_ACTIVE_LOW : 0) |
+            (Bias == ButtonBias::PullDown ? GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN :
+             Bias == ButtonBias::PullUp   ? GPIO_V2_LINE_FLAG_BIAS_PULL_UP :
+                                            GPIO_V2_LINE_FLAG_BIAS_DISABLED);
+
+        static constexpr int64_t DEBOUNCE_NS = static_cast<int64_t>(DebounceUs) * 1000LL;  ///< Window in ns
+        static constexpr unsigned int EVENT_BATCH = 16;     ///< Kernel events per read()
+
+        static constexpr std::array<char, 24> PATH = gpiochipPath(Chip);  ///< Chip device path
+
+        int               _fd = -1;         ///< uAPI v2 line request fd
+        ButtonDelegate    _cb;              ///< Edge callback
+        int64_t           _last_ns = -1;    ///< Last accepted edge (-1 = none)
+        std::atomic<bool> _state{false};    ///< Cached LOGICAL state
+
+        /**
+         * @brief LOGICAL line value: 1/0, or -1 on error.
+         */
+        int _readLine(void) const;
+};
+
+// #################################################################################
+// StaticButton template implementation:
+
+template <unsigned int Chip, unsigned int Pin, ButtonPolarity Polarity, ButtonBias Bias, AUXI::Edge Edge, uint32_t DebounceUs>
+bool StaticButton<Chip, Pin, Polarity, Bias, Edge, DebounceUs>::begin(ButtonDelegate cb)
+{
+    if (!cb) {
+        errorMessage = "StaticButton: callback is null.";
+        return false;
+    }
+    clean();
+
+    const int chipfd = ::open(PATH.data(), O_RDWR | O_CLOEXEC);
+    if (chipfd < 0) {
+        errorMessage = std::string("StaticButton: failed to open ") + PATH.data() + ".";
+        return false;
+    }
+
+    gpio_v2_line_request req{};
+    req.offsets[0] = Pin;
+    req.num_lines = 1;
+    std::strncpy(req.consumer, "StaticButton", sizeof(req.consumer) - 1);
+    req.config.flags = FLAGS;
+    req.event_buffer_size = EVENT_BATCH * 4;
+
+    const int rc = ::ioctl(chipfd, GPIO_V2_GET_LINE_IOCTL, &req);
+    const int err = errno;
+    ::close(chipfd);
+
+    if (rc < 0) {
+        errorMessage = "StaticButton: line request failed for line " + std::to_string(Pin) +
+                       ": " + std::strerror(err);
+        return false;
+    }
+
+    _fd = req.fd;
+    const int fl = ::fcntl(_fd, F_GETFL);
+    if (fl >= 0) ::fcntl(_fd, F_SETFL, fl | O_NONBLOCK);
+
+    _cb = cb;
+    _last_ns = -1;
+    _state.store(_readLine() == 1, std::memory_order_release);
+    return true;
+}
+
+template <unsigned int Chip, unsigned int Pin, ButtonPolarity Polarity, ButtonBias Bias, AUXI::Edge Edge, uint32_t DebounceUs>
+size_t StaticButton<Chip, Pin, Polarity, Bias, Edge, DebounceUs>::processPendingEvents(void)
+{
+    if (_fd < 0) return 0;
+
+    gpio_v2_line_event raw[EVENT_BATCH];
+    size_t total = 0;
+
+    for (;;) {
+        const ssize_t rd = ::read(_fd, raw, sizeof(raw));
+        if (rd <= 0) return total;
+        const size_t n = static_cast<size_t>(rd) / sizeof(raw[0]);
+        total += n;
+
+        // Both edges: the newest event is the level; single edge: the kernel hides the other edge
+        if constexpr (Edge == AUXI::Edge::Both) {
+            _state.store(raw[n - 1].id == GPIO_V2_LINE_EVENT_RISING_EDGE, std::memory_order_release);
+        } else {
+            const int v = _readLine();
+            _state.store(v >= 0 ? (v == 1) : (Edge == AUXI::Edge::Rising), std::memory_order_release);
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            const int64_t ns = static_cast<int64_t>(raw[i].timestamp_ns);
+            if constexpr (DebounceUs != 0) {
+                if (_last_ns >= 0 && (ns - _last_ns) < DEBOUNCE_NS) continue;    // bounce
+                _last_ns = ns;
+            }
+
+            bool rising;
+            if constexpr (Edge == AUXI::Edge::Both) rising = raw[i].id == GPIO_V2_LINE_EVENT_RISING_EDGE;
+            else                                    rising = (Edge == AUXI::Edge::Rising);
+
+            _cb(rising, static_cast<uint64_t>(ns));
+        }
+
+        if (n < EVENT_BATCH) return total;      // kernel FIFO drained
+    }
+}
+
+template <unsigned int Chip, unsigned int Pin, ButtonPolarity Polarity, ButtonBias Bias, AUXI::Edge Edge, uint32_t DebounceUs>
+bool StaticButton<Chip, Pin, Polarity, Bias, Edge, DebounceUs>::read(void)
+{
+    const int v = _readLine();
+    if (v < 0) return get();
+    _state.store(v == 1, std::memory_order_release);
+    return v == 1;
+}
+
+template <unsigned int Chip, unsigned int Pin, ButtonPolarity Polarity, ButtonBias Bias, AUXI::Edge Edge, uint32_t DebounceUs>
+void StaticButton<Chip, Pin, Polarity, Bias, Edge, DebounceUs>::clean(void)
+{
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+}
+
+template <unsigned int Chip, unsigned int Pin, ButtonPolarity Polarity, ButtonBias Bias, AUXI::Edge Edge, uint32_t DebounceUs>
+int StaticButton<Chip, Pin, Polarity, Bias, Edge, DebounceUs>::_readLine(void) const
+{
+    if (_fd < 0) return -1;
+    gpio_v2_line_values vals{};
+    vals.mask = 1;
+    if (::ioctl(_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &vals) < 0) return -1;
+    return static_cast<int>(vals.bits & 1);
+}
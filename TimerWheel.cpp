@@ -0,0 +1,196 @@
+// #######################################################################
+// Include Libraries:
+
+#include "TimerWheel.h"
+#include <ctime>
+
+// #######################################################################
+// TimerWheel class:
+
+TimerWheel::TimerWheel(uint32_t tick_us)
+: _tick_ns(static_cast<int64_t>(tick_us ? tick_us : 1) * 1000LL),
+  _cur_tick(now() / _tick_ns)
+{}
+
+void TimerWheel::schedule(Timer& t, int64_t deadline_ns)
+{
+    if (t.armed) {
+        _forget(t);
+        _unlink(t);
+    }
+    t.deadline_ns = deadline_ns;
+
+    // An empty wheel is not advanced while its loop idles: catch up before linking
+    if (_count == 0) {
+        const int64_t tick = now() / _tick_ns;
+        if (tick > _cur_tick) _cur_tick = tick;
+    }
+    _link(t);
+    if (_nextValid && (_next < 0 || deadline_ns < _next)) _next = deadline_ns;
+}
+
+void TimerWheel::cancel(Timer& t)
+{
+    if (!t.armed) return;
+    _forget(t);
+    _unlink(t);
+}
+
+size_t TimerWheel::advance(int64_t now_ns)
+{
+    const int64_t target = now_ns / _tick_ns;
+    size_t fired = 0;
+
+    // Overdue timers armed since the last call sit in the slot of _cur_tick + 1
+    while (_cur_tick < target && _count > 0) {
+        size_t empty = 0;
+        while (_levelCount[empty] == 0) ++empty;     // _count > 0: some level is occupied
+        if (empty > 0) {
+            // Levels below `empty` hold nothing: skip straight to that level's next cascade boundary
+            const int64_t boundary = _cur_tick | ((int64_t(1) << (LEVEL_BITS * empty)) - 1);
+            if (boundary >= target) break;
+            _cur_tick = boundary;
+        }
+
+        const int64_t tick = ++_cur_tick;
+        const size_t idx0 = static_cast<size_t>(tick) & (SLOTS - 1);
+
+        // Level 0 wrapped: pull the next slot of each higher level down
+        if (idx0 == 0) {
+            for (size_t lvl = 1; lvl < LEVELS; ++lvl) {
+                const size_t idx = static_cast<size_t>(tick >> (LEVEL_BITS * lvl)) & (SLOTS - 1);
+                _cascade(lvl, idx);
+                if (idx != 0) break;
+            }
+        }
+        _fireSlot(&_slots[0][idx0], now_ns, fired);
+    }
+    if (_cur_tick < target) _cur_tick = target;     // nothing left armed: skip the rest
+    return fired;
+}
+
+int64_t TimerWheel::nextDeadline(void) const
+{
+    if (_count == 0) return -1;
+    if (_nextValid) return _next;
+
+    int64_t best = -1;
+    for (size_t l = 0; l < LEVELS; ++l) {
+        if (_levelCount[l] == 0) continue;
+        for (size_t s = 0; s < SLOTS; ++s) {
+            for (const Timer* t = _slots[l][s]; t; t = t->next) {
+                if (best < 0 || t->deadline_ns < best) best = t->deadline_ns;
+            }
+        }
+    }
+    _next = best;
+    _nextValid = true;
+    return best;
+}
+
+int TimerWheel::timeoutMs(int64_t now_ns) const
+{
+    const int64_t d = nextDeadline();
+    if (d < 0) return -1;
+    if (d <= now_ns) return 0;
+    const int64_t ms = (d - now_ns + 999999LL) / 1000000LL;
+    return ms > 0x7fffffffLL ? 0x7fffffff : static_cast<int>(ms);
+}
+
+size_t TimerWheel::size(void) const
+{
+    return _count;
+}
+
+int64_t TimerWheel::now(void)
+{
+    timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+void TimerWheel::_link(Timer& t)
+{
+    int64_t tick = t.deadline_ns / _tick_ns;
+    const int64_t base = _cur_tick;
+
+    // Overdue timers go to the next slot to be processed
+    if (tick <= base) tick = base + 1;
+
+    int64_t delta = tick - base;
+    const int64_t span = int64_t(1) << (LEVEL_BITS * LEVELS);
+    if (delta >= span) {
+        tick = base + span - 1;     // park far deadlines; re-cascaded until due
+        delta = span - 1;
+    }
+
+    size_t lvl = 0;
+    while (lvl + 1 < LEVELS && delta >= (int64_t(1) << (LEVEL_BITS * (lvl + 1)))) ++lvl;
+    const size_t idx = static_cast<size_t>(tick >> (LEVEL_BITS * lvl)) & (SLOTS - 1);
+
+    Timer** head = &_slots[lvl][idx];
+    t.head = head;
+    t.level = lvl;
+    t.prev = nullptr;
+    t.next = *head;
+    if (t.next) t.next->prev = &t;
+    *head = &t;
+    t.armed = true;
+    ++_count;
+    ++_levelCount[lvl];
+}
+
+void TimerWheel::_unlink(Timer& t)
+{
+    if (t.prev) t.prev->next = t.next;
+    else *t.head = t.next;
+    if (t.next) t.next->prev = t.prev;
+    _detached(t);
+}
+
+void TimerWheel::_detached(Timer& t)
+{
+    t.next = t.prev = nullptr;
+    t.head = nullptr;
+    t.armed = false;
+    --_count;
+    --_levelCount[t.level];
+}
+
+void TimerWheel::_forget(const Timer& t)
+{
+    // Only losing the earliest timer invalidates the cache; cascades keep deadlines
+    if (t.deadline_ns <= _next) _nextValid = false;
+}
+
+void TimerWheel::_cascade(size_t level, size_t idx)
+{
+    Timer* list = _slots[level][idx];
+    _slots[level][idx] = nullptr;
+
+    while (list) {
+        Timer* t = list;
+        list = t->next;
+        _detached(*t);
+        _link(*t);      // lands in a lower level now that it is closer
+    }
+}
+
+void TimerWheel::_fireSlot(Timer** head, int64_t now_ns, size_t& fired)
+{
+    // Pop one timer at a time and re-read the head: a callback may cancel or
+    // re-arm any other timer of this slot. Re-armed and kept timers always
+    // land in a later slot, so the loop ends.
+    while (Timer* t = *head) {
+        _unlink(*t);
+
+        if (t->deadline_ns <= now_ns) {
+            _forget(*t);
+            ++fired;
+            if (t->fn) t->fn(t->ctx);
+        }
+        else {
+            _link(*t);  // sub-tick remainder or parked far deadline: keep it
+        }
+    }
+}
@@ -0,0 +1,140 @@
+/**
+ * @file TimerWheel.h
+ * @brief Hierarchical timer wheel shared by all buttons of an event loop.
+ *
+ * Timers are intrusive nodes owned by the caller, so scheduling and
+ * cancelling never allocate and cost O(1). Four cascading levels of 64 slots
+ * cover 2^24 ticks (about 4.6 hours at 1 ms ticks); longer deadlines are
+ * parked in the top level and re-cascaded until due. Deadlines are absolute
+ * CLOCK_MONOTONIC nanoseconds, the same clock as kernel line event
+ * timestamps, so a timer can be armed directly from an edge timestamp.
+ */
+
+// ################################################################################
+
+#pragma once
+
+// #################################################################################
+// Include libraries:
+
+#include <cstddef>
+#include <cstdint>
+
+// #################################################################################
+// TimerWheel class:
+
+/**
+ * @class TimerWheel
+ * @brief Single-threaded hierarchical timing wheel with intrusive timers.
+ *
+ * The wheel is driven by one thread: either by ButtonGroup (see
+ * ButtonGroup::setTimerWheel()) or manually through advance(). Expired timers
+ * fire their callback from advance(); callbacks may re-arm or cancel timers.
+ */
+class TimerWheel
+{
+    public:
+
+        /**
+         * @brief Timer expiry callback.
+         */
+        using Callback = void(*)(void* ctx);
+
+        /**
+         * @brief Intrusive timer node (embed it in the object it belongs to).
+         */
+        struct Timer
+        {
+            Callback    fn = nullptr;           ///< Expiry callback
+            void*       ctx = nullptr;          ///< Callback context
+            int64_t     deadline_ns = 0;        ///< Absolute CLOCK_MONOTONIC deadline
+            Timer*      next = nullptr;         ///< Next timer in the slot list
+            Timer*      prev = nullptr;         ///< Previous timer in the slot list
+            Timer**     head = nullptr;         ///< Slot list head the timer is linked in
+            size_t      level = 0;              ///< Wheel level the timer is linked in
+            bool        armed = false;          ///< True while scheduled
+        };
+
+        /**
+         * @brief Slots per level, as a bit count (64 slots).
+         */
+        static constexpr unsigned int LEVEL_BITS = 6;
+
+        /**
+         * @brief Slots per level.
+         */
+        static constexpr size_t SLOTS = size_t(1) << LEVEL_BITS;
+
+        /**
+         * @brief Number of cascading levels.
+         */
+        static constexpr size_t LEVELS = 4;
+
+        /**
+         * @brief Construct a wheel.
+         * @param tick_us Slot granularity in microseconds (default 1000).
+         */
+        explicit TimerWheel(uint32_t tick_us = 1000);
+
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        /**
+         * @brief Arm (or re-arm) a timer for an absolute deadline.
+         * @param t           Timer node (fn/ctx must be set).
+         * @param deadline_ns Absolute CLOCK_MONOTONIC deadline in nanoseconds.
+         */
+        void schedule(Timer& t, int64_t deadline_ns);
+
+        /**
+         * @brief Disarm a timer (no-op if not armed).
+         */
+        void cancel(Timer& t);
+
+        /**
+         * @brief Fire every timer whose deadline is <= @p now_ns.
+         * @return Number of timers fired.
+         */
+        size_t advance(int64_t now_ns);
+
+        /**
+         * @brief Earliest armed deadline, or -1 if no timer is armed.
+         *
+         * Cached: O(1) unless the earliest timer fired or was cancelled since
+         * the last call, which rescans the occupied levels once.
+         */
+        int64_t nextDeadline(void) const;
+
+        /**
+         * @brief Milliseconds until the next deadline, rounded up (for poll/epoll timeouts).
+         * @return Timeout in ms, 0 if already due, or -1 if no timer is armed.
+         */
+        int timeoutMs(int64_t now_ns) const;
+
+        /**
+         * @brief Number of armed timers.
+         */
+        size_t size(void) const;
+
+        /**
+         * @brief Current CLOCK_MONOTONIC time in nanoseconds.
+         */
+        static int64_t now(void);
+
+    private:
+
+        int64_t _tick_ns;                       ///< Level-0 slot granularity
+        int64_t _cur_tick;                      ///< Last tick processed by advance()
+        size_t  _count = 0;                     ///< Armed timers
+        size_t  _levelCount[LEVELS] = {};       ///< Armed timers per level
+        Timer*  _slots[LEVELS][SLOTS] = {};     ///< Slot list heads per level
+        mutable int64_t _next = -1;             ///< Cached earliest deadline (-1 = none armed)
+        mutable bool    _nextValid = true;      ///< False once the cached earliest timer left
+
+        void _link(Timer& t);
+        void _unlink(Timer& t);
+        void _cascade(size_t level, size_t idx);
+        void _fireSlot(Timer** head, int64_t now_ns, size_t& fired);
+        void _detached(Timer& t);
+        void _forget(const Timer& t);
+};
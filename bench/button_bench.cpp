@@ -0,0 +1,217 @@
+/**
+ * @file button_bench.cpp
+ * @brief Edge-to-callback latency and throughput benchmark for Button::beginInterrupt().
+ *
+ * Drives a simulated GPIO line through gpio-sim (configfs), so it runs on a
+ * normal Linux box without hardware. Reports:
+ * - edge-to-callback latency distribution (p50/p99/p999/max)
+ * - lost edges at each tested rate and the maximum sustainable edge rate
+ * - CPU time of the event thread per delivered event
+ *
+ * Requirements: root, `modprobe gpio-sim`, configfs mounted at /sys/kernel/config.
+ *
+ * Usage:
+ *   sudo ./button_bench [--rate EDGES_PER_S] [--count N] [--sweep]
+ *
+ *   --rate   Fixed toggle rate for the latency run (default 1000).
+ *   --count  Edges per run (default 20000).
+ *   --sweep  Double the rate from 1 kHz until edges are lost and report the last clean rate.
+ */
+
+ // g++ -std=c++17 -O2 -lpthread -lgpiod -o button_bench bench/button_bench.cpp Button.cpp ButtonChip.cpp ButtonError.cpp ButtonTrace.cpp ButtonGroup.cpp ButtonBank.cpp ButtonUring.cpp DebounceEngine.cpp TimerWheel.cpp LatencyHistogram.cpp ButtonBackendUapi.cpp ButtonBackendGpiodV1.cpp ButtonBackendGpiodV2.cpp ButtonInput.cpp AUXIO.cpp
+
+#include "../Button.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <pthread.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// #######################################################################
+// gpio-sim helpers:
+
+static const char* SIM_DIR = "/sys/kernel/config/gpio-sim/button-bench";
+
+static bool writeFile(const std::string& path, const std::string& value)
+{
+    std::ofstream f(path);
+    if (!f) return false;
+    f << value;
+    return static_cast<bool>(f.flush());
+}
+
+static std::string readFile(const std::string& path)
+{
+    std::ifstream f(path);
+    std::string s;
+    std::getline(f, s);
+    return s;
+}
+
+/**
+ * @brief Simulated one-line gpiochip created through gpio-sim configfs.
+ */
+struct SimChip
+{
+    std::string chipPath;       ///< /dev/gpiochipN of the simulated chip
+    std::string pullPath;       ///< sysfs attribute that drives line 0
+
+    bool create(void)
+    {
+        const std::string bank = std::string(SIM_DIR) + "/bank0";
+        if (::mkdir(SIM_DIR, 0755) < 0 && errno != EEXIST) return false;
+        if (::mkdir(bank.c_str(), 0755) < 0 && errno != EEXIST) return false;
+        if (!writeFile(bank + "/num_lines", "1")) return false;
+        if (!writeFile(std::string(SIM_DIR) + "/live", "1")) return false;
+
+        const std::string chip = readFile(bank + "/chip_name");
+        const std::string dev = readFile(std::string(SIM_DIR) + "/dev_name");
+        if (chip.empty() || dev.empty()) return false;
+
+        chipPath = "/dev/" + chip;
+        pullPath = "/sys/devices/platform/" + dev + "/" + chip + "/sim_gpio0/pull";
+        return true;
+    }
+
+    void destroy(void)
+    {
+        writeFile(std::string(SIM_DIR) + "/live", "0");
+        ::rmdir((std::string(SIM_DIR) + "/bank0").c_str());
+        ::rmdir(SIM_DIR);
+    }
+};
+
+// #######################################################################
+// Benchmark:
+
+static std::atomic<uint64_t> g_received{0};
+static std::atomic<bool>     g_haveThread{false};
+static pthread_t             g_eventThread;
+
+static void onEdge(bool, long, long)
+{
+    if (!g_haveThread.load(std::memory_order_relaxed)) {
+        g_eventThread = pthread_self();
+        g_haveThread.store(true, std::memory_order_release);
+    }
+    g_received.fetch_add(1, std::memory_order_relaxed);
+}
+
+static int64_t threadCpuNs(void)
+{
+    if (!g_haveThread.load(std::memory_order_acquire)) return 0;
+    clockid_t cid;
+    if (pthread_getcpuclockid(g_eventThread, &cid) != 0) return 0;
+    timespec ts;
+    ::clock_gettime(cid, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+/**
+ * @brief Result of one fixed-rate run.
+ */
+struct RunResult
+{
+    uint64_t sent;          ///< Edges generated
+    uint64_t received;      ///< Callbacks observed
+    double   cpuNsPerEvent; ///< Event thread CPU time per delivered event
+};
+
+static RunResult runAtRate(Button& btn, const SimChip& sim, double rate, uint64_t count)
+{
+    std::ofstream pull(sim.pullPath);
+    const uint64_t start = g_received.load();
+    const int64_t cpu0 = threadCpuNs();
+    const int64_t period = static_cast<int64_t>(1e9 / rate);
+
+    timespec next;
+    ::clock_gettime(CLOCK_MONOTONIC, &next);
+    bool up = !btn.read();
+
+    for (uint64_t i = 0; i < count; ++i) {
+        pull << (up ? "pull-up" : "pull-down") << std::flush;
+        up = !up;
+
+        next.tv_nsec += period;
+        while (next.tv_nsec >= 1000000000L) { next.tv_nsec -= 1000000000L; ++next.tv_sec; }
+        ::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+    }
+
+    // Let the event thread drain what is still queued
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    RunResult r;
+    r.sent = count;
+    r.received = g_received.load() - start;
+    const int64_t cpu = threadCpuNs() - cpu0;
+    r.cpuNsPerEvent = r.received ? static_cast<double>(cpu) / static_cast<double>(r.received) : 0.0;
+    return r;
+}
+
+int main(int argc, char** argv)
+{
+    double   rate = 1000.0;
+    uint64_t count = 20000;
+    bool     sweep = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--rate") && i + 1 < argc)       rate = std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--count") && i + 1 < argc) count = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--sweep"))                 sweep = true;
+        else {
+            std::cerr << "usage: " << argv[0] << " [--rate EDGES_PER_S] [--count N] [--sweep]\n";
+            return 2;
+        }
+    }
+
+    SimChip sim;
+    if (!sim.create()) {
+        std::cerr << "gpio-sim setup failed (root? modprobe gpio-sim? configfs mounted?)\n";
+        sim.destroy();
+        return 1;
+    }
+
+    int rc = 0;
+    {
+        Button btn(sim.chipPath.c_str(), 0, /*mode=*/1, /*bias=*/0);
+        btn.enableLatencyStats();
+
+        if (!btn.beginInterrupt(AUXI::Edge::Both, /*debounce_us=*/0, onEdge)) {
+            std::cerr << "beginInterrupt failed: " << btn.errorMessage << "\n";
+            rc = 1;
+        }
+        else {
+            RunResult r = runAtRate(btn, sim, rate, count);
+            const LatencyHistogram* lat = btn.deliveryLatency();
+
+            std::printf("rate %.0f edges/s: sent %llu, received %llu, lost %llu\n", rate,
+                        static_cast<unsigned long long>(r.sent), static_cast<unsigned long long>(r.received),
+                        static_cast<unsigned long long>(r.sent > r.received ? r.sent - r.received : 0));
+            std::printf("edge-to-callback latency [us]: p50 %.1f  p99 %.1f  p999 %.1f  max %.1f\n",
+                        lat->p50() / 1e3, lat->p99() / 1e3, lat->p999() / 1e3, lat->max() / 1e3);
+            std::printf("event thread CPU per event: %.0f ns\n", r.cpuNsPerEvent);
+
+            if (sweep) {
+                double lastClean = 0.0;
+                for (double rt = 1000.0; rt <= 1e6; rt *= 2.0) {
+                    RunResult s = runAtRate(btn, sim, rt, count);
+                    const double loss = s.sent ? 1.0 - static_cast<double>(s.received) / static_cast<double>(s.sent) : 0.0;
+                    std::printf("sweep %8.0f edges/s: loss %.3f%%, %.0f ns CPU/event\n", rt, loss * 100.0, s.cpuNsPerEvent);
+                    if (loss > 0.001) break;
+                    lastClean = rt;
+                }
+                std::printf("max sustainable edge rate: %.0f edges/s\n", lastClean);
+            }
+        }
+        btn.clean();
+    }
+
+    sim.destroy();
+    return rc;
+}
@@ -4,15 +4,17 @@
  *
  * Demonstrates:
  * - Configuring a GPIO pin as a button input
- * - Polling the button state in a loop
+ * - Waiting for edges without a library thread and without timeouts
+ *   (zero wakeups while the button is idle)
  * - Using interrupt-driven callbacks with debounce
  */
 
- // g++ -std=c++17 -O2 -lpthread -lgpiod -o button_demo button_demo.cpp Button.cpp AUXIO.cpp
+ // g++ -std=c++17 -O2 -lpthread -lgpiod -o button_demo button_demo.cpp Button.cpp Encoder.cpp ButtonChip.cpp ButtonError.cpp ButtonTrace.cpp ButtonReplay.cpp ButtonGroup.cpp ButtonBank.cpp ButtonUring.cpp GestureEngine.cpp TimerWheel.cpp DebounceEngine.cpp LatencyHistogram.cpp ButtonBackendUapi.cpp ButtonBackendGpiodV1.cpp ButtonBackendGpiodV2.cpp ButtonInput.cpp AUXIO.cpp
+
 
- 
 #include <csignal>
 #include <iostream>
+#include <poll.h>
 #include "Button.h"
 
 // GPIO line to use for button (adjust per board mapping)
@@ -32,33 +34,35 @@ void myButtonHandler(bool rising, long sec, long nsec) {
 }
 
 int main() {
-    std::signal(SIGINT, sigintHandler);
+    // No SA_RESTART: Ctrl+C interrupts the blocking poll() below
+    struct sigaction sa{};
+    sa.sa_handler = sigintHandler;
+    sigaction(SIGINT, &sa, nullptr);
 
-    Button btn(BUTTON_PIN, PULL_MODE);
+    Button btn("/dev/gpiochip0", BUTTON_PIN, /*mode=*/0, PULL_MODE);
 
-    if (!btn.begin()) {
+    // Option 1: Event mode on this thread. poll() has no timeout, so the CPU
+    // is only woken by an edge (or Ctrl+C) instead of every 200 ms.
+    if (!btn.beginEvents(0, 5000, myButtonHandler)) {  // 0=Both edges
         std::cerr << "Init error: " << btn.errorMessage << "\n";
         return 1;
     }
+    std::cout << "Waiting for button events (Ctrl+C to quit)...\n";
 
-    // Option 1: Polling mode
-    std::cout << "Polling button... Press Ctrl+C to exit.\n";
+    pollfd pfd{btn.eventFd(), POLLIN, 0};
     while (running) {
-        if (btn.state()) {
-            std::cout << "Button pressed!\n";
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        if (::poll(&pfd, 1, -1) > 0) btn.processPendingEvents();
     }
 
-    // Option 2: Interrupt mode (uncomment to test)
+    // Option 2: Interrupt mode with the library thread (uncomment to test);
+    // it blocks the same way, so the main thread can simply sleep in pause().
     /*
-    if (!btn.beginInterrupt(myButtonHandler, true, 5000)) {
+    if (!btn.beginInterrupt(0, 5000, myButtonHandler)) {
         std::cerr << "Interrupt error: " << btn.errorMessage << "\n";
         return 1;
     }
-    std::cout << "Waiting for button events (Ctrl+C to quit)...\n";
     while (running) {
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+        ::pause();
     }
     */
 